@@ -105,13 +105,13 @@ namespace vkn
 
         // The VknDevice factory method should have already called addNewObject<VkBuffer,...>
         // which reserves a spot in VknEngine's vector. We just need to create the buffer into that spot.
-        VknResult res = {vmaCreateBuffer(s_engine->getObject<VmaAllocator>(m_absIdxs),
-                                         &bufferInfo,
-                                         &allocCreateInfo,
-                                         &s_engine->getObject<VkBuffer>(m_absIdxs),        // VknEngine stores the VkBuffer
-                                         &s_engine->addNewAllocation<VkBuffer>(m_absIdxs), // And the allocation
-                                         &m_allocInfo),                                    // To get mapped data if VMA_ALLOCATION_CREATE_MAPPED_BIT is set
-                         "VMA Create Buffer"};
+        VknResult res{"VMA Create Buffer", this->traceArgs<VkBuffer>()};
+        res = vmaCreateBuffer(s_engine->getObject<VmaAllocator>(m_absIdxs),
+                              &bufferInfo,
+                              &allocCreateInfo,
+                              &s_engine->getObject<VkBuffer>(m_absIdxs),        // VknEngine stores the VkBuffer
+                              &s_engine->addNewAllocation<VkBuffer>(m_absIdxs), // And the allocation
+                              &m_allocInfo);                                    // To get mapped data if VMA_ALLOCATION_CREATE_MAPPED_BIT is set
 
         m_vkBuffer = s_engine->getObject<VkBuffer>(m_absIdxs); // Store local handle for convenience
         m_allocation = s_engine->getObject<VmaAllocation>(m_absIdxs);
@@ -17,9 +17,9 @@ namespace vkn
         poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT; // Allows resetting individual command buffers
         poolInfo.queueFamilyIndex = queueFamilyIndex;
 
-        VknResult res{vkCreateCommandPool(
-                          s_engine->getObject<VkDevice>(m_absIdxs), &poolInfo, nullptr, &s_engine->getObject<VkCommandPool>(m_absIdxs)),
-                      "Create command pool"};
+        VknResult res{"Create command pool", this->traceArgs<VkCommandPool>()};
+        res = vkCreateCommandPool(
+            s_engine->getObject<VkDevice>(m_absIdxs), &poolInfo, nullptr, &s_engine->getObject<VkCommandPool>(m_absIdxs));
         m_commandPoolCreated = true;
     }
 
@@ -38,9 +38,9 @@ namespace vkn
         allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY; // Primary can be submitted to queues
         allocInfo.commandBufferCount = numSwapchainImages;
 
-        VknResult res{vkAllocateCommandBuffers(
-                          s_engine->getObject<VkDevice>(m_absIdxs), &allocInfo, s_engine->getObject<VkCommandBuffer *>(m_absIdxs)),
-                      "Allocate command buffers"};
+        VknResult res{"Allocate command buffers", this->traceArgs<VkCommandBuffer *>()};
+        res = vkAllocateCommandBuffers(
+            s_engine->getObject<VkDevice>(m_absIdxs), &allocInfo, s_engine->getObject<VkCommandBuffer *>(m_absIdxs));
         m_commandBuffersAllocated = true;
     }
 
@@ -94,11 +94,10 @@ namespace vkn
         this->fileAppInfo();
         this->fileInstanceCreateInfo();
         s_engine->addVkInstance(m_relIdxs, m_absIdxs);
-        VknResult res{
-            vkCreateInstance(
-                s_infos->getInstanceCreateInfo(), VK_NULL_HANDLE,
-                s_engine->getVector<VkInstance>().getData()),
-            "Create instance."};
+        VknResult res{"Create instance.", this->traceArgs<VkInstance>()};
+        res = vkCreateInstance(
+            s_infos->getInstanceCreateInfo(), VK_NULL_HANDLE,
+            s_engine->getVector<VkInstance>().getData());
 
         if (m_validationLayerAdded)
             this->setupDebugMessenger();
@@ -112,10 +111,10 @@ namespace vkn
         if (!m_createdInstance)
             throw std::runtime_error("Instance not created before setting up debug messenger.");
         s_engine->addNewObject<VkDebugUtilsMessengerEXT, VkInstance>(m_absIdxs);
-        VknResult res{createDebugUtilsMessengerEXT(
-                          s_engine->getObject<VkInstance>(0), &populateDebugMessengerCreateInfo(),
-                          nullptr, &s_engine->getObject<VkDebugUtilsMessengerEXT>(m_absIdxs)),
-                      "Create debug messenger"};
+        VknResult res{"Create debug messenger", this->traceArgs<VkDebugUtilsMessengerEXT>()};
+        res = createDebugUtilsMessengerEXT(
+            s_engine->getObject<VkInstance>(0), &populateDebugMessengerCreateInfo(),
+            nullptr, &s_engine->getObject<VkDebugUtilsMessengerEXT>(m_absIdxs));
     }
 
     VknDevice *VknConfig::getDevice(uint32_t deviceIdx)
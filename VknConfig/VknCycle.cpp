@@ -58,6 +58,8 @@ namespace vkn
         // 1. Wait for the previous frame to finish
         vkWaitForFences(
             *m_device->getVkDevice(), 1u, &m_device->getFence(m_currentFrame), VK_TRUE, m_defaultTimeout);
+        if (m_currentFrame < m_fenceSerials.size()) // Everything retired up to that frame is now unused
+            m_engine->destroyRetired(m_fenceSerials[m_currentFrame]);
 
         //*device->getVkDevice(), 1, &inFlightFences[currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max());
     }
@@ -125,8 +127,16 @@ namespace vkn
         // Correctly iterate through pipelines: bind, set state, and draw for each one.
         for (VknPipeline &pipeline : *renderpass->getPipelines())
         {
-            // 1. Bind the pipeline
-            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline.getVkPipeline());
+            // 1. Bind the pipeline, or its fallback while an async build is still compiling it
+            VknPipeline *bound{&pipeline};
+            if (!pipeline.isReady())
+            {
+                renderpass->checkPipelineBuild(); // A failed build never reports ready
+                bound = pipeline.getFallback();
+                if (!bound || !bound->isReady())
+                    continue; // Nothing to draw with yet
+            }
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *bound->getVkPipeline());
 
             // 2. Set dynamic states for this pipeline
             VknViewportState *viewportState = pipeline.getViewportState();
@@ -135,6 +145,26 @@ namespace vkn
                 vkCmdSetViewport(commandBuffer, 0, 1, &viewportState->getVkViewport(0));
                 vkCmdSetScissor(commandBuffer, 0, 1, &viewportState->getVkScissor(0));
             }
+            VknExtendedDynamicState extendedDynamicState{bound->getDynamicState()->getExtendedDynamicState()};
+            if (extendedDynamicState > m_device->getExtendedDynamicState())
+                throw std::runtime_error("Pipeline uses more extended dynamic state than its device enabled.");
+            if (extendedDynamicState != EXTENDED_DYNAMIC_STATE_NONE)
+            {
+                // The bound pipeline may be shared with ones differing in these, so its own values are set
+                const VknExtendedDynamicStateCommands &commands{m_device->getExtendedDynamicStateCommands()};
+                VknRasterizationState *rasterizationState = bound->getRasterizationState();
+                VknInputAssemblyState *inputAssemblyState = bound->getInputAssemblyState();
+                commands.setCullMode(commandBuffer, rasterizationState->getCullMode());
+                commands.setFrontFace(commandBuffer, rasterizationState->getFrontFace());
+                commands.setPrimitiveTopology(commandBuffer, inputAssemblyState->getTopology());
+                if (extendedDynamicState >= EXTENDED_DYNAMIC_STATE_2)
+                {
+                    commands.setPrimitiveRestartEnable(commandBuffer, inputAssemblyState->getPrimitiveRestartEnable());
+                    commands.setDepthBiasEnable(commandBuffer, rasterizationState->getDepthBiasEnable());
+                }
+                if (extendedDynamicState >= EXTENDED_DYNAMIC_STATE_3)
+                    commands.setPolygonMode(commandBuffer, rasterizationState->getPolygonMode());
+            }
 
             // 3. Check how to draw for this pipeline
             VknVertexInputState *vertexInputState = pipeline.getVertexInputState();
@@ -203,6 +233,11 @@ namespace vkn
         // and potentially perform multiple submissions.
         QueueType submissionQueue = m_graphicsConfigLoaded ? PRESENT : COMPUTE;
         m_resSubmit = vkQueueSubmit(*m_device->getQueue(submissionQueue), 1, &m_submitInfo, m_device->getFence(m_currentFrame));
+
+        if (m_currentFrame >= m_fenceSerials.size())
+            m_fenceSerials.resize(m_currentFrame + 1u, 0u);
+        m_fenceSerials[m_currentFrame] = ++m_frameSerial;
+        m_engine->setFrameSerial(m_frameSerial);
     }
 
     void VknCycle::downloadData()
@@ -253,8 +288,6 @@ namespace vkn
         if (!m_config->getWindow()->isActive())
             return false;
 
-        vkDeviceWaitIdle(*m_device->getVkDevice());
-
         // Critical check: Re-query surface capabilities *directly* before attempting swapchain recreation.
         // This ensures we have the absolute latest extent information.
 
@@ -280,15 +313,18 @@ namespace vkn
 
     void VknCycle::recreateForWindowChange()
     {
+        // An async pipeline build still reads the infos, viewport states included, that change below
+        for (auto &renderpass : *m_renderpasses)
+            renderpass.waitForPipelines();
         for (auto &renderpass : *m_renderpasses)
             renderpass.demolishFramebuffers();
+        m_config->getInfos()->resetRebuildInfos(); // Everything filed for the framebuffers is gone
 
+        // Old framebuffers, attachments and the old swapchain are retired to the engine, not destroyed, so no
+        // device wait is needed. recreateSwapchain() keeps the image count, so the sync objects and
+        // m_imagesInFlight stay valid and keep gating command buffer reuse across the resize.
         m_swapchain->recreateSwapchain();
         m_vkSwapchains[0] = *m_swapchain->getVkSwapchain(); // Update
-        m_device->recreateSyncObjects();
-
-        // Reset m_imagesInFlight for the new swapchain
-        m_imagesInFlight.assign(m_swapchain->getNumImages(), nullptr);
 
         for (auto &renderpass : *m_renderpasses)
         {
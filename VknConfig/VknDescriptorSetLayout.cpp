@@ -25,11 +25,11 @@ namespace vkn
     {
         VkDescriptorSetLayoutCreateInfo *createInfo = s_infos->fileDescriptorSetLayoutCreateInfo(
             m_bindings, m_createFlags);
-        VknResult res{
-            vkCreateDescriptorSetLayout(
-                s_engine->getObject<VkDevice>(m_absIdxs),
-                createInfo, nullptr,
-                &s_engine->getObject<VkDescriptorSetLayout>(m_absIdxs)),
-            "Create descriptor set layout."};
+        VknResult res{"Create descriptor set layout.", this->traceArgs<VkDescriptorSetLayout>()};
+        res = vkCreateDescriptorSetLayout(
+            s_engine->getObject<VkDevice>(m_absIdxs),
+            createInfo, nullptr,
+            &s_engine->getObject<VkDescriptorSetLayout>(m_absIdxs));
+        s_infos->hashDescriptorSetLayout(s_engine->getObject<VkDescriptorSetLayout>(m_absIdxs), *createInfo);
     }
 }
\ No newline at end of file
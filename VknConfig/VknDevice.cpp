@@ -29,6 +29,32 @@ namespace vkn
         return &s_engine->getObject<VkDevice>(m_absIdxs);
     }
 
+    VkPipelineCache VknDevice::getPipelineCache()
+    {
+        return s_engine->getPipelineCache(this->getVkDevice());
+    }
+
+    void VknDevice::createPipelineCache()
+    {
+        VkPhysicalDeviceProperties &properties{this->getPhysicalDevice()->getProperties()};
+        std::filesystem::path path{};
+        std::vector<char> blob{};
+        if (!m_pipelineCacheDir.empty())
+        {
+            path = VknPipelineCacheFile::keyedPath(m_pipelineCacheDir, properties);
+            blob = VknPipelineCacheFile::load(path, properties); // Starts cold if empty
+        }
+        VkPipelineCacheCreateInfo *createInfo{
+            s_infos->filePipelineCacheCreateInfo(m_relIdxs, blob.size(), blob.data(), 0)};
+        VkPipelineCache &cache{s_engine->addNewObject<VkPipelineCache, VkDevice>(m_absIdxs)};
+        VknResult res{"Create pipeline cache.", this->traceArgs<VkPipelineCache>()};
+        res = vkCreatePipelineCache(s_engine->getObject<VkDevice>(m_absIdxs), createInfo, nullptr, &cache);
+        createInfo->initialDataSize = 0; // The blob goes out of scope
+        createInfo->pInitialData = nullptr;
+        if (!path.empty())
+            s_engine->setPipelineCachePath(cache, path);
+    }
+
     VknRenderpass *VknDevice::getRenderpass(uint32_t renderpassIdx)
     {
         return getListElement(renderpassIdx, m_renderpasses);
@@ -206,13 +232,15 @@ namespace vkn
         s_infos->fileDeviceFeaturesInfo();
 
         s_infos->fileDeviceCreateInfo(m_relIdxs.get<VkDevice>());
-        VknResult res{
-            vkCreateDevice(
-                *(getListElement(0, m_physicalDevices)->getVkPhysicalDevice()),
-                s_infos->getDeviceCreateInfo(m_relIdxs.get<VkDevice>()),
-                nullptr,
-                &s_engine->getObject<VkDevice>(m_absIdxs)),
-            "Create device"};
+        VknResult res{"Create device", this->traceArgs<VkDevice>()};
+        res = vkCreateDevice(
+            *(getListElement(0, m_physicalDevices)->getVkPhysicalDevice()),
+            s_infos->getDeviceCreateInfo(m_relIdxs.get<VkDevice>()),
+            nullptr,
+            &s_engine->getObject<VkDevice>(m_absIdxs));
+        this->createPipelineCache();
+        if (m_extendedDynamicState != EXTENDED_DYNAMIC_STATE_NONE)
+            this->loadExtendedDynamicStateCommands();
 
         if (s_engine->getVectorSize<VkSurfaceKHR>() > 0)
         {
@@ -264,6 +292,88 @@ namespace vkn
             renderpassIdx, m_renderpasses, m_relIdxs, m_absIdxs);
     }
 
+    bool VknDevice::enablePipelineLibrary()
+    {
+        if (m_createdVkDevice)
+            throw std::runtime_error("Pipeline libraries must be enabled before the device is created.");
+        if (m_pipelineLibraryEnabled)
+            return true;
+        VknPhysicalDevice *physicalDevice = this->getPhysicalDevice();
+        if (!physicalDevice->m_selectedPhysicalDevice)
+            physicalDevice->selectPhysicalDevice();
+        if (!physicalDevice->supportsGraphicsPipelineLibrary())
+            return false;
+        this->addExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        this->addExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+        if (!features->features2.graphicsPipelineLibrary())
+            features->features2.graphicsPipelineLibrary(true); // It's a toggle
+        m_pipelineLibraryEnabled = true;
+        return true;
+    }
+
+    VknExtendedDynamicState VknDevice::enableExtendedDynamicState()
+    {
+        if (m_createdVkDevice)
+            throw std::runtime_error("Extended dynamic state must be enabled before the device is created.");
+        if (m_extendedDynamicState != EXTENDED_DYNAMIC_STATE_NONE)
+            return m_extendedDynamicState;
+        VknPhysicalDevice *physicalDevice = this->getPhysicalDevice();
+        if (!physicalDevice->m_selectedPhysicalDevice)
+            physicalDevice->selectPhysicalDevice();
+        m_extendedDynamicState = physicalDevice->getExtendedDynamicStateSupport();
+
+        // The feature getters are toggles
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_1)
+        {
+            this->addExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+            if (!features->features2.extendedDynamicState())
+                features->features2.extendedDynamicState(true);
+        }
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_2)
+        {
+            this->addExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+            if (!features->features2.extendedDynamicState2())
+                features->features2.extendedDynamicState2(true);
+        }
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_3)
+        {
+            this->addExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+            if (!features->features2.extendedDynamicState3PolygonMode())
+                features->features2.extendedDynamicState3PolygonMode(true);
+        }
+        return m_extendedDynamicState;
+    }
+
+    void VknDevice::loadExtendedDynamicStateCommands()
+    {
+        VkDevice device{s_engine->getObject<VkDevice>(m_absIdxs)};
+        VknExtendedDynamicStateCommands &commands{m_extendedDynamicStateCommands};
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_1)
+        {
+            commands.setCullMode = (PFN_vkCmdSetCullModeEXT)vkGetDeviceProcAddr(device, "vkCmdSetCullModeEXT");
+            commands.setFrontFace = (PFN_vkCmdSetFrontFaceEXT)vkGetDeviceProcAddr(device, "vkCmdSetFrontFaceEXT");
+            commands.setPrimitiveTopology =
+                (PFN_vkCmdSetPrimitiveTopologyEXT)vkGetDeviceProcAddr(device, "vkCmdSetPrimitiveTopologyEXT");
+            if (!commands.setCullMode || !commands.setFrontFace || !commands.setPrimitiveTopology)
+                throw std::runtime_error("Failed to load VK_EXT_extended_dynamic_state commands.");
+        }
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_2)
+        {
+            commands.setPrimitiveRestartEnable =
+                (PFN_vkCmdSetPrimitiveRestartEnableEXT)vkGetDeviceProcAddr(device, "vkCmdSetPrimitiveRestartEnableEXT");
+            commands.setDepthBiasEnable =
+                (PFN_vkCmdSetDepthBiasEnableEXT)vkGetDeviceProcAddr(device, "vkCmdSetDepthBiasEnableEXT");
+            if (!commands.setPrimitiveRestartEnable || !commands.setDepthBiasEnable)
+                throw std::runtime_error("Failed to load VK_EXT_extended_dynamic_state2 commands.");
+        }
+        if (m_extendedDynamicState >= EXTENDED_DYNAMIC_STATE_3)
+        {
+            commands.setPolygonMode = (PFN_vkCmdSetPolygonModeEXT)vkGetDeviceProcAddr(device, "vkCmdSetPolygonModeEXT");
+            if (!commands.setPolygonMode)
+                throw std::runtime_error("Failed to load VK_EXT_extended_dynamic_state3 commands.");
+        }
+    }
+
     void VknDevice::addExtension(std::string extension)
     {
         if (extension == VK_KHR_SWAPCHAIN_EXTENSION_NAME)
@@ -293,7 +403,7 @@ namespace vkn
         allocatorInfo.instance = s_engine->getObject<VkInstance>(m_absIdxs);
         allocatorInfo.vulkanApiVersion = s_infos->getAppInfo()->apiVersion;
 
-        VknResult res{"Create VMA allocator."};
+        VknResult res{"Create VMA allocator.", this->traceArgs<VmaAllocator>()};
         res = vmaCreateAllocator(&allocatorInfo, &allocator);
         return &allocator;
     }
@@ -24,14 +24,38 @@ namespace vkn
 
     void VknDynamicState::addDynamicState(VkDynamicState dynamicState)
     {
-        for (int i = 0; i < m_dynamicStates.size(); i++)
-        {
-            if (m_dynamicStates(i) == dynamicState)
-                throw std::runtime_error("Dynamic state has already been added.");
-        }
+        if (this->hasDynamicState(dynamicState))
+            throw std::runtime_error("Dynamic state has already been added.");
         m_dynamicStates.appendOne(dynamicState);
     }
 
+    bool VknDynamicState::hasDynamicState(VkDynamicState dynamicState)
+    {
+        for (uint_fast32_t i = 0; i < m_dynamicStates.getSize(); ++i)
+            if (m_dynamicStates(i) == dynamicState)
+                return true;
+        return false;
+    }
+
+    void VknDynamicState::_addExtendedDynamicStates(VknExtendedDynamicState level)
+    {
+        if (m_filedCreateInfo)
+            throw std::runtime_error("Extended dynamic states added after the dynamic state create info was filed.");
+        std::vector<VkDynamicState> states{};
+        if (level >= EXTENDED_DYNAMIC_STATE_1)
+            states.insert(states.end(), {VK_DYNAMIC_STATE_CULL_MODE_EXT, VK_DYNAMIC_STATE_FRONT_FACE_EXT,
+                                         VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT});
+        if (level >= EXTENDED_DYNAMIC_STATE_2)
+            states.insert(states.end(), {VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT,
+                                         VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT});
+        if (level >= EXTENDED_DYNAMIC_STATE_3)
+            states.push_back(VK_DYNAMIC_STATE_POLYGON_MODE_EXT);
+        for (VkDynamicState state : states)
+            if (!this->hasDynamicState(state))
+                m_dynamicStates.appendOne(state);
+        m_extendedDynamicState = level;
+    }
+
     VkPipelineDynamicStateCreateInfo *VknDynamicState::_fileDynamicStateCreateInfo()
     {
         VkPipelineDynamicStateCreateInfo *result = s_infos->fileDynamicStateCreateInfo(
@@ -17,39 +17,312 @@ namespace vkn
             this->shutdown();
     }
 
-    void VknEngine::shutdown()
+    void VknEngine::setFrameSerial(uint_fast64_t serial)
     {
-        if (!m_poweredOn) // If already shut down, do nothing
+        std::scoped_lock lock{m_retiredLock};
+        m_frameSerial = serial;
+    }
+
+    void VknEngine::retire(VkDevice device, std::function<void()> destroy)
+    {
+        std::scoped_lock lock{m_retiredLock};
+        m_retired.push_back(VknRetired{device, m_frameSerial, std::move(destroy)});
+    }
+
+    void VknEngine::destroyRetired(uint_fast64_t completedSerial)
+    {
+        std::vector<std::function<void()>> ready{};
+        {
+            std::scoped_lock lock{m_retiredLock};
+            while (!m_retired.empty() && m_retired.front().serial <= completedSerial)
+            {
+                ready.push_back(std::move(m_retired.front().destroy));
+                m_retired.pop_front();
+            }
+        }
+        if (ready.empty())
             return;
-        m_poweredOn = false; // Set immediately to prevent re-entrancy issues from destructor
+        VknTraceScope trace{"Destroy retired", "demolish",
+                            VknTrace::isEnabled() ? "{\"count\":" + std::to_string(ready.size()) + "}" : ""};
+        for (auto &destroy : ready)
+            destroy();
+    }
+
+    void VknEngine::destroyRetired(VkDevice device)
+    {
+        std::vector<std::function<void()>> ready{};
+        {
+            std::scoped_lock lock{m_retiredLock};
+            for (auto &retired : m_retired)
+                if (retired.device == device)
+                    ready.push_back(std::move(retired.destroy));
+            std::erase_if(m_retired, [device](const VknRetired &retired)
+                          { return retired.device == device; });
+        }
+        for (auto &destroy : ready)
+            destroy();
+    }
+
+    void VknEngine::addDeviceWork(VkDevice device, std::shared_future<void> work)
+    {
+        std::scoped_lock lock{m_deviceWorkLock};
+        std::erase_if(m_deviceWork, [](const std::pair<VkDevice, std::shared_future<void>> &entry)
+                      { return entry.second.wait_for(std::chrono::seconds{0}) == std::future_status::ready; });
+        m_deviceWork.emplace_back(device, std::move(work));
+    }
+
+    VkPipeline VknEngine::findPipeline(VkDevice device, VknHash hash)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipeline>()};
+        auto found = m_pipelinesByHash.find({device, hash});
+        if (found == m_pipelinesByHash.end())
+            return VK_NULL_HANDLE;
+        ++m_sharedPipelines.at(found->second).refs;
+        return found->second;
+    }
+
+    VkPipeline VknEngine::registerPipeline(VkDevice device, VknHash hash, VkPipeline pipeline)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipeline>()};
+        auto [registered, inserted] = m_pipelinesByHash.emplace(std::pair{device, hash}, pipeline);
+        if (!inserted) // Both builds missed, the first to register wins
+        {
+            ++m_sharedPipelines.at(registered->second).refs;
+            return registered->second;
+        }
+        m_sharedPipelines.emplace(pipeline, VknSharedPipeline{device, hash, 1u});
+        return pipeline;
+    }
+
+    bool VknEngine::releasePipeline(VkPipeline pipeline)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipeline>()};
+        auto shared = m_sharedPipelines.find(pipeline);
+        if (shared == m_sharedPipelines.end())
+            return true; // Never shared
+        if (--shared->second.refs > 0u)
+            return false;
+        m_pipelinesByHash.erase({shared->second.device, shared->second.hash});
+        m_sharedPipelines.erase(shared);
+        return true;
+    }
+
+    VkPipeline VknEngine::findPipelineLibrary(VkDevice device, VknHash hash)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipeline>()};
+        auto found = m_pipelineLibraries.find({device, hash});
+        if (found == m_pipelineLibraries.end())
+            return VK_NULL_HANDLE;
+        return found->second;
+    }
 
-        // Wait for each device to idle before demolishing resources
-        for (auto &device : this->getVector<VkDevice>())
-            vkDeviceWaitIdle(device);
+    VkPipeline VknEngine::registerPipelineLibrary(VkDevice device, VknHash hash, VkPipeline library)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipeline>()};
+        return m_pipelineLibraries.emplace(std::pair{device, hash}, library).first->second;
+    }
 
-        this->demolishObjects<VkShaderModule, VkDevice>(vkDestroyShaderModule);
-        this->demolishObjects<VkDescriptorSetLayout, VkDevice>(vkDestroyDescriptorSetLayout);
+    void VknEngine::setPipelineCachePath(VkPipelineCache cache, std::filesystem::path path)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipelineCache>()};
+        m_pipelineCachePaths[cache] = std::move(path);
+    }
 
-        this->demolishObjects<VkPipelineLayout, VkDevice>(vkDestroyPipelineLayout);
-        this->demolishObjects<VkPipelineCache, VkDevice>(vkDestroyPipelineCache);
-        this->demolishObjects<VkPipeline, VkDevice>(vkDestroyPipeline);
-        this->demolishObjects<VkFramebuffer, VkDevice>(vkDestroyFramebuffer);
-        this->demolishObjects<VkRenderPass, VkDevice>(vkDestroyRenderPass);
+    VkPipelineCache VknEngine::getPipelineCache(VkDevice *device)
+    {
+        std::scoped_lock lock{this->typeLock<VkPipelineCache>()};
+        if (!m_hasObjectVector[typeSlot<VkPipelineCache>()])
+            return VK_NULL_HANDLE;
+        VknEngineVector<VkPipelineCache> &caches{std::get<typeSlot<VkPipelineCache>()>(m_objectVectors)};
+        VknParentVector<VkPipelineCache> &parents{std::get<typeSlot<VkPipelineCache>()>(m_parentVectors)};
+        for (uint_fast32_t i = 0; i < caches.getSize(); ++i)
+            if (parents(caches.getPosition(i)) == device)
+                return caches.begin()[i];
+        return VK_NULL_HANDLE;
+    }
 
-        this->demolishObjects<VkImageView, VkDevice>(vkDestroyImageView);
-        this->demolishAllocations<VkImage>(vmaDestroyImage);
-        this->demolishAllocations<VkBuffer>(vmaDestroyBuffer);
+    VknEngineStats VknEngine::collectStats()
+    {
+        VknEngineStats stats{};
+        VknEngineTypes::forEach(
+            [this, &stats]<typename T>()
+            {
+                std::scoped_lock lock{this->typeLock<T>()};
+                if (!m_hasObjectVector[typeSlot<T>()])
+                    return;
+                VknEngineVector<T> &objects{std::get<typeSlot<T>()>(m_objectVectors)};
+                VknTypeStats &typeStats{stats.types.emplace_back()};
+                typeStats.type = typeToStr<T>();
+                typeStats.count = objects.getSize();
+                typeStats.positions = objects.getNumPositions();
+                typeStats.capacity = objects.getCapacity();
+                typeStats.maxPositions = VknEngineVector<T>::s_maxDataSize;
+                if (m_hasParentVector[typeSlot<T>()])
+                    typeStats.parents = std::get<typeSlot<T>()>(m_parentVectors).getSize();
+                if (m_hasAllocationVector[typeSlot<T>()])
+                    typeStats.allocations = std::get<typeSlot<T>()>(m_allocations).getSize();
+                if (typeStats.positions > 0)
+                    typeStats.fragmentation =
+                        static_cast<float>(typeStats.positions - typeStats.count) / typeStats.positions;
+            });
+
+        std::scoped_lock lock{this->typeLock<VmaAllocator>()};
+        if (m_hasObjectVector[typeSlot<VmaAllocator>()])
+        {
+            VknEngineVector<VmaAllocator> &allocators{std::get<typeSlot<VmaAllocator>()>(m_objectVectors)};
+            for (uint_fast32_t i = 0; i < allocators.getSize(); ++i)
+            {
+                VmaTotalStatistics vmaStats{};
+                vmaCalculateStatistics(allocators.begin()[i], &vmaStats);
+                VknAllocatorStats &allocatorStats{stats.allocators.emplace_back()};
+                allocatorStats.position = allocators.getPosition(i);
+                allocatorStats.blockCount = vmaStats.total.statistics.blockCount;
+                allocatorStats.allocationCount = vmaStats.total.statistics.allocationCount;
+                allocatorStats.unusedRangeCount = vmaStats.total.unusedRangeCount;
+                allocatorStats.blockBytes = vmaStats.total.statistics.blockBytes;
+                allocatorStats.allocationBytes = vmaStats.total.statistics.allocationBytes;
+            }
+        }
+        return stats;
+    }
+
+    std::string VknEngineStats::toJson() const
+    {
+        // Type names are plain identifiers, so nothing needs escaping
+        std::ostringstream json{};
+        json << "{\"types\":[";
+        for (uint_fast32_t i = 0; i < types.size(); ++i)
+        {
+            const VknTypeStats &t{types[i]};
+            json << (i ? "," : "") << "{\"type\":\"" << t.type << "\",\"count\":" << t.count
+                 << ",\"positions\":" << t.positions << ",\"capacity\":" << t.capacity
+                 << ",\"maxPositions\":" << t.maxPositions << ",\"parents\":" << t.parents
+                 << ",\"allocations\":" << t.allocations << ",\"fragmentation\":" << t.fragmentation << "}";
+        }
+        json << "],\"allocators\":[";
+        for (uint_fast32_t i = 0; i < allocators.size(); ++i)
+        {
+            const VknAllocatorStats &a{allocators[i]};
+            json << (i ? "," : "") << "{\"position\":" << a.position << ",\"blockCount\":" << a.blockCount
+                 << ",\"allocationCount\":" << a.allocationCount << ",\"unusedRangeCount\":" << a.unusedRangeCount
+                 << ",\"blockBytes\":" << a.blockBytes << ",\"allocationBytes\":" << a.allocationBytes << "}";
+        }
+        json << "]}";
+        return json.str();
+    }
 
-        this->demolishCommandBuffers();
-        this->demolishObjects<VkCommandPool, VkDevice>(vkDestroyCommandPool);
-        this->demolishObjects<VkSwapchainKHR, VkDevice>(vkDestroySwapchainKHR);
-        this->demolishObjects<VkSemaphore, VkDevice>(vkDestroySemaphore);
-        this->demolishObjects<VkFence, VkDevice>(vkDestroyFence);
+    void VknEngine::demolishDevice(VkDevice *device)
+    {
+        VknTraceScope trace{"Demolish device", "demolish"};
+        std::vector<std::shared_future<void>> work{};
+        {
+            std::scoped_lock lock{m_deviceWorkLock};
+            for (auto &entry : m_deviceWork)
+                if (entry.first == *device)
+                    work.push_back(entry.second);
+        }
+        for (auto &entry : work)
+            entry.wait(); // Failures are for whoever started the work to collect
+        vkDeviceWaitIdle(*device);
+        this->destroyRetired(*device);
+        std::vector<VmaAllocator *> allocators{this->getChildAllocators(device)};
+
+        // Each type goes before anything it was created from or allocated through
+        this->demolishChildren<VkShaderModule>(device, vkDestroyShaderModule);
+        this->demolishChildren<VkDescriptorSetLayout>(device, vkDestroyDescriptorSetLayout);
+        this->demolishChildren<VkPipelineLayout>(device, vkDestroyPipelineLayout);
+        this->demolishChildren<VkPipelineCache>(
+            device, [this](VkDevice device, VkPipelineCache cache, const VkAllocationCallbacks *pAllocator)
+            {
+                std::scoped_lock lock{this->typeLock<VkPipelineCache>()};
+                auto path = m_pipelineCachePaths.find(cache);
+                if (path != m_pipelineCachePaths.end())
+                {
+                    VknPipelineCacheFile::save(device, cache, path->second); // A failed save only costs a cold start
+                    m_pipelineCachePaths.erase(path);
+                }
+                vkDestroyPipelineCache(device, cache, pAllocator);
+            });
+        this->demolishChildren<VkPipeline>(
+            device, [this](VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator)
+            {
+                if (this->releasePipeline(pipeline)) // Shared pipelines sit in several slots
+                    vkDestroyPipeline(device, pipeline, pAllocator);
+            });
+        {
+            // Linked pipelines don't need their libraries, but nothing can link from them anymore either
+            std::scoped_lock lock{this->typeLock<VkPipeline>()};
+            for (auto library = m_pipelineLibraries.begin(); library != m_pipelineLibraries.end();)
+            {
+                if (library->first.first != *device)
+                {
+                    ++library;
+                    continue;
+                }
+                vkDestroyPipeline(*device, library->second, nullptr);
+                library = m_pipelineLibraries.erase(library);
+            }
+        }
+        this->demolishChildren<VkFramebuffer>(device, vkDestroyFramebuffer);
+        this->demolishChildren<VkRenderPass>(device, vkDestroyRenderPass);
+        this->demolishChildren<VkImageView>(device, vkDestroyImageView);
+        this->demolishChildAllocations<VkImage>(allocators, vmaDestroyImage);
+        this->demolishChildAllocations<VkBuffer>(allocators, vmaDestroyBuffer);
+        this->demolishChildCommandBuffers(device);
+        this->demolishChildren<VkCommandPool>(device, vkDestroyCommandPool);
+        this->demolishChildren<VkSwapchainKHR>(device, vkDestroySwapchainKHR);
+        this->demolishChildren<VkSemaphore>(device, vkDestroySemaphore);
+        this->demolishChildren<VkFence>(device, vkDestroyFence);
+        for (VmaAllocator *allocator : allocators)
+            vmaDestroyAllocator(*allocator);
+        this->demolishChildren<VkDeviceMemory>(device, vkFreeMemory);
+        vkDestroyDevice(*device, VK_NULL_HANDLE);
+    }
+
+    void VknEngine::shutdown()
+    {
+        if (!m_poweredOn) // If already shut down, do nothing
+            return;
+        m_poweredOn = false; // Set immediately to prevent re-entrancy issues from destructor
+        VknTraceScope trace{"Engine shutdown", "demolish"};
 
-        this->demolishAllocators();
-        this->demolishObjects<VkDeviceMemory, VkDevice>(vkFreeMemory);
+        // Devices share nothing below them, so each is idled and torn down on its own thread. A single device
+        // stays on this thread.
+        VknEngineVector<VkDevice> &devices{this->getVector<VkDevice>()};
+        if (devices.getSize() == 1u)
+            this->demolishDevice(devices.begin());
+        else
+        {
+            std::vector<std::thread> workers{};
+            std::vector<std::exception_ptr> errors(devices.getSize());
+            workers.reserve(devices.getSize());
+            for (uint_fast32_t i = 0; i < devices.getSize(); ++i)
+                workers.emplace_back(
+                    [this, &devices, &errors, i]()
+                    {
+                        try
+                        {
+                            this->demolishDevice(devices.begin() + i);
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                    });
+            for (auto &worker : workers)
+                worker.join();
+            for (auto &error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+        this->deleteAllVectors<VkShaderModule, VkDescriptorSetLayout, VkPipelineLayout, VkPipelineCache,
+                               VkPipeline, VkFramebuffer, VkRenderPass, VkImageView, VkImage, VkBuffer,
+                               VkCommandPool, VkSwapchainKHR, VkSemaphore, VkFence, VmaAllocator,
+                               VkDeviceMemory, VkDevice>();
+        this->deleteAllocationVector<VkImage>();
+        this->deleteAllocationVector<VkBuffer>();
+        this->deleteVector<VkCommandBuffer *>();
 
-        this->demolishDevices();
         this->demolishObjects<VkSurfaceKHR, VkInstance>(vkDestroySurfaceKHR);
         this->demolishDebugObjects<VkDebugUtilsMessengerEXT, VkInstance>(
             [this](VkInstance instance, VkDebugUtilsMessengerEXT messenger, const VkAllocationCallbacks *pAllocator)
@@ -62,19 +335,20 @@ namespace vkn
             this->deleteVector<VkQueueFamilyProperties>();
         this->deleteVector<VkPhysicalDevice>();
 
-        if (this->exists<uint32_t>())
-            this->deleteVector<uint32_t>(); // i think it was num command buffers for each command pool
+        this->deleteVector<uint32_t>(); // Number of command buffers in each command pool
 
         delete static_cast<VknVector<size_t> *>(m_emptyVec);
         m_emptyVec = nullptr;
 
-        if (!m_objectVectors.empty())
-            throw std::runtime_error("Some keys were not deleted from m_objectVectors.");
+        auto inUse = [](bool flag)
+        { return flag; };
+        if (std::any_of(m_hasObjectVector.begin(), m_hasObjectVector.end(), inUse))
+            throw std::runtime_error("Some object vectors were not deleted.");
 
-        if (!m_parentVectors.empty())
-            throw std::runtime_error("Some keys were not deleted from m_parentVectors.");
+        if (std::any_of(m_hasParentVector.begin(), m_hasParentVector.end(), inUse))
+            throw std::runtime_error("Some parent vectors were not deleted.");
 
-        if (!m_allocations.empty())
-            throw std::runtime_error("Some keys were not deleted from m_allocations.");
+        if (std::any_of(m_hasAllocationVector.begin(), m_hasAllocationVector.end(), inUse))
+            throw std::runtime_error("Some allocation vectors were not deleted.");
     }
 }
\ No newline at end of file
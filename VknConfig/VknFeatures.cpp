@@ -601,6 +601,42 @@ namespace vkn
             (*pNext) = &m_protectedMemory;
             pNext = &m_protectedMemory.pNext;
         }
+
+        if (m_features["graphicsPipelineLibrary"])
+        {
+            m_graphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+            m_graphicsPipelineLibrary.graphicsPipelineLibrary = VK_TRUE; // Pipelines linked from cached parts.
+            m_graphicsPipelineLibrary.pNext = nullptr;
+            (*pNext) = &m_graphicsPipelineLibrary;
+            pNext = &m_graphicsPipelineLibrary.pNext;
+        }
+
+        if (m_features["extendedDynamicState"])
+        {
+            m_extendedDynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+            m_extendedDynamicState.extendedDynamicState = VK_TRUE; // Cull mode, front face, topology and more.
+            m_extendedDynamicState.pNext = nullptr;
+            (*pNext) = &m_extendedDynamicState;
+            pNext = &m_extendedDynamicState.pNext;
+        }
+
+        if (m_features["extendedDynamicState2"])
+        {
+            m_extendedDynamicState2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+            m_extendedDynamicState2.extendedDynamicState2 = VK_TRUE; // Primitive restart, depth bias enable.
+            m_extendedDynamicState2.pNext = nullptr;
+            (*pNext) = &m_extendedDynamicState2;
+            pNext = &m_extendedDynamicState2.pNext;
+        }
+
+        if (m_features["extendedDynamicState3PolygonMode"])
+        {
+            m_extendedDynamicState3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+            m_extendedDynamicState3.extendedDynamicState3PolygonMode = VK_TRUE; // Only polygon mode is used.
+            m_extendedDynamicState3.pNext = nullptr;
+            (*pNext) = &m_extendedDynamicState3;
+            pNext = &m_extendedDynamicState3.pNext;
+        }
         /*
         // Query the physical device for its supported features.
         vkGetPhysicalDeviceFeatures2(physicalDevice, &deviceFeatures2);
@@ -640,4 +676,48 @@ namespace vkn
                 m_features["protectedMemory"] = true;
         return m_features["protectedMemory"];
     }
+
+    // Enable Graphics Pipeline Libraries.
+    bool VknFeatures2::graphicsPipelineLibrary(bool toggle)
+    {
+        if (toggle)
+            if (m_features["graphicsPipelineLibrary"])
+                m_features["graphicsPipelineLibrary"] = false;
+            else
+                m_features["graphicsPipelineLibrary"] = true;
+        return m_features["graphicsPipelineLibrary"];
+    }
+
+    // Enable Extended Dynamic State.
+    bool VknFeatures2::extendedDynamicState(bool toggle)
+    {
+        if (toggle)
+            if (m_features["extendedDynamicState"])
+                m_features["extendedDynamicState"] = false;
+            else
+                m_features["extendedDynamicState"] = true;
+        return m_features["extendedDynamicState"];
+    }
+
+    // Enable Extended Dynamic State 2.
+    bool VknFeatures2::extendedDynamicState2(bool toggle)
+    {
+        if (toggle)
+            if (m_features["extendedDynamicState2"])
+                m_features["extendedDynamicState2"] = false;
+            else
+                m_features["extendedDynamicState2"] = true;
+        return m_features["extendedDynamicState2"];
+    }
+
+    // Enable the dynamic polygon mode of Extended Dynamic State 3.
+    bool VknFeatures2::extendedDynamicState3PolygonMode(bool toggle)
+    {
+        if (toggle)
+            if (m_features["extendedDynamicState3PolygonMode"])
+                m_features["extendedDynamicState3PolygonMode"] = false;
+            else
+                m_features["extendedDynamicState3PolygonMode"] = true;
+        return m_features["extendedDynamicState3PolygonMode"];
+    }
 }
\ No newline at end of file
@@ -56,11 +56,10 @@ namespace vkn
 
         VkFramebufferCreateInfo *createInfo =
             s_infos->getFramebufferCreateInfo(m_relIdxs);
-        VknResult res{
-            vkCreateFramebuffer(
-                s_engine->getObject<VkDevice>(m_absIdxs), createInfo, VK_NULL_HANDLE,
-                &s_engine->getObject<VkFramebuffer>(m_absIdxs)),
-            "Create framebuffer."};
+        VknResult res{"Create framebuffer.", this->traceArgs<VkFramebuffer>()};
+        res = vkCreateFramebuffer(
+            s_engine->getObject<VkDevice>(m_absIdxs), createInfo, VK_NULL_HANDLE,
+            &s_engine->getObject<VkFramebuffer>(m_absIdxs));
         m_createdFramebuffer = true;
     }
 
@@ -79,7 +78,7 @@ namespace vkn
         VknSpace<VkAttachmentDescription> *descriptions = s_infos->getRenderpassAttachmentDescriptions(
             m_relIdxs);
 
-        if (descriptions->getDataSize() == 0)
+        if (!descriptions || descriptions->getDataSize() == 0)
         {
             m_addedAttachments = true; // No descriptions, so attachments are "set" (to none)
             return;
@@ -123,11 +122,15 @@ namespace vkn
                 // Default subresource range in VknImageView is usually fine for color/depth.
 
                 VkImageUsageFlags accumulatedUsage = 0;                                         // Start fresh for this image
-                for (VknSpace<VkAttachmentReference> &subPassSpace : refs->getSubspaceVector()) // Iterate subpasses (references)
+                VknVector<VknSpace<VkAttachmentReference>> noRefs{};
+                for (VknSpace<VkAttachmentReference> &subPassSpace : refs ? refs->getSubspaceVector() : noRefs) // Iterate subpasses (references)
                 {
-                    for (uint32_t j = 0; j < subPassSpace.getNumSubspaces(); ++j) // Iterate attachment types (references)
+                    for (uint32_t j = 0; j < NUM_ATTACHMENT_TYPES; ++j) // Iterate attachment types (references)
                     {
-                        for (VkAttachmentReference &attachmentRef : subPassSpace[j].getDataVector()) // Iterate attachment references
+                        VknSpace<VkAttachmentReference> *typeSpace{subPassSpace.find(j)};
+                        if (!typeSpace)
+                            continue;
+                        for (VkAttachmentReference &attachmentRef : typeSpace->getDataVector()) // Iterate attachment references
                             if (attachmentRef.attachment == i)
                             {
 
@@ -203,12 +206,13 @@ namespace vkn
         }
     }
 
-    VknVectorIterator<VkImageView> VknFramebuffer::getAttachmentImageViews()
+    VknEngineIterator<VkImageView> VknFramebuffer::getAttachmentImageViews()
     {
         if (!m_addedAttachments)
             throw std::runtime_error("Attachments not set before trying to get() them.");
 
-        if (s_infos->getRenderpassAttachmentDescriptions(m_relIdxs)->getDataSize() == 0)
+        VknSpace<VkAttachmentDescription> *descriptions{s_infos->getRenderpassAttachmentDescriptions(m_relIdxs)};
+        if (!descriptions || descriptions->getDataSize() == 0)
             return s_engine->getVectorSlice<VkImageView>(m_imageViewStartIdx, 0);
         else
             return s_engine->getVectorSlice<VkImageView>(m_imageViewStartIdx, m_attachViews.size());
@@ -228,8 +232,11 @@ namespace vkn
         }
         // This should be called once per framebuffer, not inside the attachment loop.
         s_infos->removeFramebufferCreateInfo(m_relIdxs);
-        vkDestroyFramebuffer(
-            s_engine->getObject<VkDevice>(m_absIdxs), s_engine->getObject<VkFramebuffer>(m_absIdxs), nullptr);
+        VkDevice device{s_engine->getObject<VkDevice>(m_absIdxs)};
+        VkFramebuffer framebuffer{s_engine->getObject<VkFramebuffer>(m_absIdxs)};
+        s_engine->retire(device, [device, framebuffer]()
+                         { vkDestroyFramebuffer(device, framebuffer, nullptr); });
+        s_engine->setObject<VkFramebuffer>(m_absIdxs, VK_NULL_HANDLE); // Destroying the null handle at shutdown is a no-op
 
         // Reset state flags to allow for recreation. This makes demolish a true teardown.
         m_addedAttachments = false;
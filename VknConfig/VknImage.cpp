@@ -30,12 +30,12 @@ namespace vkn
         // VmaAllocator vmaAllocator = s_engine->getDevice(m_absIdxs.get<VkDevice>())->getVmaAllocator();
         // For now, let's assume it's directly accessible via s_engine->getObject
 
-        VknResult res{vmaCreateImage(s_engine->getObject<VmaAllocator>(m_absIdxs),
-                                     imageInfo, &allocInfo,
-                                     &s_engine->getObject<VkImage>(m_absIdxs), // VknEngine stores the VkImage handle
-                                     &s_engine->addNewAllocation<VkImage>(m_absIdxs),
-                                     nullptr), // Optional: VmaAllocationInfo
-                      "VMA Create Image"};
+        VknResult res{"VMA Create Image", this->traceArgs<VkImage>()};
+        res = vmaCreateImage(s_engine->getObject<VmaAllocator>(m_absIdxs),
+                             imageInfo, &allocInfo,
+                             &s_engine->getObject<VkImage>(m_absIdxs), // VknEngine stores the VkImage handle
+                             &s_engine->addNewAllocation<VkImage>(m_absIdxs),
+                             nullptr); // Optional: VmaAllocationInfo
 
         m_createdVkImage = true;
     }
@@ -46,7 +46,13 @@ namespace vkn
             throw std::runtime_error("VknImage::demolishImage called before createImage().");
         ; // Or throw
         VmaAllocator vmaAllocator = s_engine->getObject<VmaAllocator>(m_absIdxs);
-        vmaDestroyImage(vmaAllocator, s_engine->getObject<VkImage>(m_absIdxs), m_allocation);
+        VkImage image{s_engine->getObject<VkImage>(m_absIdxs)};
+        VmaAllocation imageAllocation{*s_engine->getAllocation<VkImage>(m_absIdxs)};
+        s_engine->retire(s_engine->getObject<VkDevice>(m_absIdxs), [vmaAllocator, image, imageAllocation]()
+                         { vmaDestroyImage(vmaAllocator, image, imageAllocation); });
+        // Written back through fresh lookups, registrations on other threads may have moved the storage
+        s_engine->setObject<VkImage>(m_absIdxs, VK_NULL_HANDLE); // Destroying the null handle at shutdown is a no-op
+        *s_engine->getAllocation<VkImage>(m_absIdxs) = VK_NULL_HANDLE;
         s_infos->removeImageCreateInfo(m_relIdxs);
         m_createdVkImage = false;
         m_allocation = VK_NULL_HANDLE; // Reset allocation handle
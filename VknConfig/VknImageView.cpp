@@ -84,9 +84,11 @@ namespace vkn
 
     void VknImageView::demolishImageView()
     {
-        vkDestroyImageView(
-            s_engine->getObject<VkDevice>(m_absIdxs),
-            s_engine->getObject<VkImageView>(m_absIdxs), nullptr);
+        // Frames in flight may still sample it, so destruction waits on their fences
+        VkDevice device{s_engine->getObject<VkDevice>(m_absIdxs)};
+        VkImageView imageView{s_engine->getObject<VkImageView>(m_absIdxs)};
+        s_engine->retire(device, [device, imageView]()
+                         { vkDestroyImageView(device, imageView, nullptr); });
 
         // Remove the CreateInfo struct from the info manager.
         s_infos->removeImageViewCreateInfo(m_absIdxs);
@@ -106,11 +108,10 @@ namespace vkn
         VkImageViewCreateInfo *ci{nullptr};
         ci = s_infos->fileImageViewCreateInfo(m_absIdxs, *this->getVkImage(),
                                               m_viewType, m_format, m_components, m_subresourceRange, m_createFlags);
-        VknResult res{
-            vkCreateImageView(s_engine->getObject<VkDevice>(m_absIdxs),
-                              ci, VK_NULL_HANDLE,
-                              &s_engine->getObject<VkImageView>(m_absIdxs)),
-            "Create image view."};
+        VknResult res{"Create image view.", this->traceArgs<VkImageView>()};
+        res = vkCreateImageView(s_engine->getObject<VkDevice>(m_absIdxs),
+                                ci, VK_NULL_HANDLE,
+                                &s_engine->getObject<VkImageView>(m_absIdxs));
         m_createdImageView = true;
     }
 }
\ No newline at end of file
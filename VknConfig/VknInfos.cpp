@@ -24,8 +24,10 @@ namespace vkn
     void VknInfos::fileDeviceQueuePriorities(VknIdxs &relIdxs, uint32_t queueFamilyIdx,
                                              VknVector<float> priorities)
     {
+        VknSpace<float> &prioritySpace = m_queuePriorities[relIdxs.get<VkDevice>()][queueFamilyIdx];
+        prioritySpace.getDataVector().reserve(prioritySpace.getDataSize() + priorities.getSize());
         for (auto &priority : priorities)
-            m_queuePriorities[relIdxs.get<VkDevice>()][queueFamilyIdx].append(priority);
+            prioritySpace.append(priority);
         m_filedDeviceQueuePriorities = true;
     }
 
@@ -372,7 +374,7 @@ namespace vkn
     }
 
     VkDescriptorSetLayoutCreateInfo *VknInfos::fileDescriptorSetLayoutCreateInfo(
-        VknVector<VkDescriptorSetLayoutBinding> bindings,
+        VknVector<VkDescriptorSetLayoutBinding> &bindings,
         VkDescriptorSetLayoutCreateFlags flags)
     {
         VkDescriptorSetLayoutCreateInfo &info =
@@ -387,7 +389,7 @@ namespace vkn
 
     VkPipelineLayoutCreateInfo *VknInfos::filePipelineLayoutCreateInfo(
         VknIdxs &relIdxs, VknVectorIterator<VkDescriptorSetLayout> setLayouts,
-        VknVector<VkPushConstantRange> pushConstantRanges,
+        VknVector<VkPushConstantRange> &pushConstantRanges,
         VkPipelineLayoutCreateFlags flags)
     {
         VkPipelineLayoutCreateInfo *info =
@@ -404,11 +406,11 @@ namespace vkn
     }
 
     VkPipelineCacheCreateInfo *VknInfos::filePipelineCacheCreateInfo(
-        size_t initialDataSize,
+        VknIdxs &relIdxs, size_t initialDataSize,
         const void *pInitialData,
         VkPipelineCacheCreateFlags flags)
     {
-        VkPipelineCacheCreateInfo &info = m_cacheCreateInfos.append(VkPipelineCacheCreateInfo{});
+        VkPipelineCacheCreateInfo &info = m_cacheCreateInfos.insert(VkPipelineCacheCreateInfo{}, relIdxs.get<VkDevice>());
         info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
         info.pNext = nullptr;
         info.flags = flags;
@@ -460,9 +462,9 @@ namespace vkn
         m_filedInstanceExtensionNames = true;
     }
 
-    void VknInfos::storeName(std::string &name, std::list<std::string> &store, VknVector<const char *> &pointers)
+    void VknInfos::storeName(std::string &name, std::pmr::list<std::pmr::string> &store, VknVector<const char *> &pointers)
     {
-        store.push_back(name);
+        store.emplace_back(name);
         pointers.appendOne(store.back().c_str());
     }
 
@@ -648,35 +650,36 @@ namespace vkn
         }
     }
 
+    // Subtree getters return nullptr if nothing was filed under them, they never add nodes.
     // Subpass>RefType>Refs
     VknSpace<VkAttachmentReference> *VknInfos::getRenderpassAttachmentReferences(
         VknIdxs &relIdxs)
     {
-        return &m_attachmentReferences[relIdxs.get<VkDevice>()][relIdxs.get<VkRenderPass>()];
+        return m_attachmentReferences.find(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>());
     }
 
     VknSpace<VkAttachmentDescription> *VknInfos::getRenderpassAttachmentDescriptions(
         VknIdxs &relIdxs)
     {
-        return &m_attachmentDescriptions[relIdxs.get<VkDevice>()][relIdxs.get<VkRenderPass>()];
+        return m_attachmentDescriptions.find(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>());
     }
 
     VknSpace<VkAttachmentReference> *VknInfos::getSubpassAttachmentReferences(
         uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
     {
-        return &m_attachmentReferences[deviceIdx][renderpassIdx][subpassIdx];
+        return m_attachmentReferences.find(deviceIdx, renderpassIdx, subpassIdx);
     }
 
     VknSpace<uint32_t> *VknInfos::getSubpassPreserveAttachments(
         uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
     {
-        return &m_preserveAttachments[deviceIdx][renderpassIdx][subpassIdx];
+        return m_preserveAttachments.find(deviceIdx, renderpassIdx, subpassIdx);
     }
 
     VknSpace<uint32_t> *VknInfos::getRenderpassPreserveAttachments(
         uint32_t deviceIdx, uint32_t renderpassIdx)
     {
-        return &m_preserveAttachments[deviceIdx][renderpassIdx];
+        return m_preserveAttachments.find(deviceIdx, renderpassIdx);
     }
 
     VkSubpassDescription *VknInfos::fileSubpassDescription(
@@ -765,13 +768,13 @@ namespace vkn
     VknSpace<VkVertexInputBindingDescription> *VknInfos::getVertexInputBindings(
         uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
     {
-        return &m_vertexInputBindings[deviceIdx][renderpassIdx][subpassIdx];
+        return m_vertexInputBindings.find(deviceIdx, renderpassIdx, subpassIdx);
     }
 
     VknSpace<VkVertexInputAttributeDescription> *VknInfos::getVertexInputAttributes(
         uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
     {
-        return &m_vertexInputAttributes[deviceIdx][renderpassIdx][subpassIdx];
+        return m_vertexInputAttributes.find(deviceIdx, renderpassIdx, subpassIdx);
     }
 
     VkImageViewCreateInfo *VknInfos::getImageViewCreateInfo(VknIdxs &relIdxs)
@@ -781,17 +784,18 @@ namespace vkn
 
     VkSwapchainCreateInfoKHR *VknInfos::getSwapchainCreateInfo(VknIdxs &relIdxs)
     {
-        return &m_swapchainCreateInfos[relIdxs.get<VkDevice>()](relIdxs.get<VkSwapchainKHR>());
+        return filed(m_swapchainCreateInfos.tryGet(relIdxs.get<VkDevice>(), relIdxs.get<VkSwapchainKHR>()), "SwapchainCreateInfoKHR");
     }
 
     VkFramebufferCreateInfo *VknInfos::getFramebufferCreateInfo(VknIdxs &relIdxs)
     {
-        return &m_framebufferCreateInfos[relIdxs.get<VkDevice>()][relIdxs.get<VkRenderPass>()](relIdxs.get<VkFramebuffer>());
+        return filed(m_framebufferCreateInfos.tryGet(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>(), relIdxs.get<VkFramebuffer>()),
+                     "FramebufferCreateInfo");
     }
 
     VkFramebufferCreateInfo *VknInfos::fileFramebufferCreateInfo(VknIdxs &relIdxs,
                                                                  VkRenderPass *renderpass,
-                                                                 VknVectorIterator<VkImageView> attachments,
+                                                                 VknEngineIterator<VkImageView> attachments,
                                                                  uint32_t width, uint32_t height, uint32_t numLayers,
                                                                  VkFramebufferCreateFlags &flags)
     {
@@ -801,8 +805,9 @@ namespace vkn
         info->sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         info->pNext = VK_NULL_HANDLE;
         info->renderPass = *renderpass;
-        info->attachmentCount = attachments.getSize();
-        info->pAttachments = attachments.getData();
+        std::span<VkImageView> attachmentViews{attachments.getSpan()};
+        info->attachmentCount = static_cast<uint32_t>(attachmentViews.size());
+        info->pAttachments = attachmentViews.data();
         info->width = width;
         info->height = height;
         info->layers = numLayers;
@@ -867,16 +872,28 @@ namespace vkn
 
     void VknInfos::removeImageViewCreateInfo(VknIdxs absIdxs)
     {
-        VknVector<VkImageViewCreateInfo> &infos = m_imageViewCreateInfos;
+        VknVector<VkImageViewCreateInfo, VknEngineIdx<VkImageView>> &infos = m_imageViewCreateInfos;
         if (infos.exists(absIdxs.get<VkImageView>()))
             infos.remove(absIdxs.get<VkImageView>());
         else
             throw std::runtime_error("Image view create info does not exist at that position.");
     }
 
+    bool VknInfos::resetRebuildInfos()
+    {
+        // Rewinding is only safe with nothing left in the arena, so skip it while anything is still filed
+        if (!m_framebufferCreateInfos.isEmpty() || !m_imageViewCreateInfos.isEmpty() || !m_imageCreateInfos.isEmpty())
+            return false;
+        m_framebufferCreateInfos = VknFlatSpace<VkFramebufferCreateInfo>{2u, &m_rebuildArena};
+        m_imageViewCreateInfos = VknVector<VkImageViewCreateInfo, VknEngineIdx<VkImageView>>{&m_rebuildArena};
+        m_imageCreateInfos = VknVector<VkImageCreateInfo, VknEngineIdx<VkImage>>{&m_rebuildArena};
+        m_rebuildArena.reset();
+        return true;
+    }
+
     void VknInfos::removeImageCreateInfo(VknIdxs relIdxs)
     {
-        VknVector<VkImageCreateInfo> &infos = m_imageCreateInfos;
+        VknVector<VkImageCreateInfo, VknEngineIdx<VkImage>> &infos = m_imageCreateInfos;
         if (infos.exists(relIdxs.get<VkImage>()))
             infos.remove(relIdxs.get<VkImage>());
         else
@@ -927,6 +944,301 @@ namespace vkn
 
         return &info;
     }
+
+    void VknInfos::hashShaderModule(VkShaderModule module, VkShaderModuleCreateInfo &info)
+    {
+        VknHasher hasher{};
+        hasher.add(info.flags);
+        hasher.addArray(reinterpret_cast<const char *>(info.pCode), info.codeSize);
+        m_shaderModuleHashes[module] = hasher.get();
+    }
+
+    void VknInfos::hashDescriptorSetLayout(VkDescriptorSetLayout layout, VkDescriptorSetLayoutCreateInfo &info)
+    {
+        VknHasher hasher{};
+        hasher.add(info.flags, info.bindingCount);
+        for (uint_fast32_t i = 0; i < info.bindingCount; ++i)
+        {
+            const VkDescriptorSetLayoutBinding &binding{info.pBindings[i]};
+            hasher.add(binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags);
+            hasher.add(binding.pImmutableSamplers != nullptr);
+            for (uint_fast32_t j = 0; binding.pImmutableSamplers && j < binding.descriptorCount; ++j)
+                hasher.add(reinterpret_cast<uint64_t>(binding.pImmutableSamplers[j])); // Same sampler, same layout
+        }
+        m_setLayoutHashes[layout] = hasher.get();
+    }
+
+    void VknInfos::hashPipelineLayout(VkPipelineLayout layout, VkPipelineLayoutCreateInfo &info)
+    {
+        VknHasher hasher{};
+        hasher.add(info.flags, info.setLayoutCount);
+        for (uint_fast32_t i = 0; i < info.setLayoutCount; ++i)
+        {
+            auto setLayout = m_setLayoutHashes.find(info.pSetLayouts[i]);
+            if (setLayout == m_setLayoutHashes.end())
+            {
+                m_pipelineLayoutHashes.erase(layout); // Leaves pipelines using this layout unshared
+                return;
+            }
+            hasher.add(setLayout->second);
+        }
+        hasher.addArray(info.pPushConstantRanges, info.pushConstantRangeCount);
+        m_pipelineLayoutHashes[layout] = hasher.get();
+    }
+
+    void VknInfos::hashRenderpass(VkRenderPass renderpass, VkRenderPassCreateInfo &info)
+    {
+        // Only what render pass compatibility depends on, so layouts and load/store ops are left out
+        if (info.pNext) // Extension structs, such as multiview, aren't walked
+        {
+            m_renderpassHashes.erase(renderpass); // Leaves pipelines using this render pass unshared
+            return;
+        }
+        VknHasher hasher{};
+        auto addRefs = [&hasher](const VkAttachmentReference *refs, uint32_t count)
+        {
+            hasher.add(refs ? count : 0u);
+            for (uint_fast32_t i = 0; refs && i < count; ++i)
+                hasher.add(refs[i].attachment);
+        };
+        hasher.add(info.flags, info.attachmentCount);
+        for (uint_fast32_t i = 0; i < info.attachmentCount; ++i)
+            hasher.add(info.pAttachments[i].flags, info.pAttachments[i].format, info.pAttachments[i].samples);
+        hasher.add(info.subpassCount);
+        for (uint_fast32_t i = 0; i < info.subpassCount; ++i)
+        {
+            const VkSubpassDescription &subpass{info.pSubpasses[i]};
+            hasher.add(subpass.flags, subpass.pipelineBindPoint);
+            addRefs(subpass.pInputAttachments, subpass.inputAttachmentCount);
+            addRefs(subpass.pColorAttachments, subpass.colorAttachmentCount);
+            addRefs(subpass.pResolveAttachments, subpass.colorAttachmentCount);
+            addRefs(subpass.pDepthStencilAttachment, 1u);
+            hasher.addArray(subpass.pPreserveAttachments, subpass.preserveAttachmentCount);
+        }
+        hasher.addArray(info.pDependencies, info.dependencyCount);
+        m_renderpassHashes[renderpass] = hasher.get();
+    }
+
+    VknHash VknInfos::hashGfxPipeline(VkGraphicsPipelineCreateInfo &info)
+    {
+        // Extension structs aren't walked, and derivatives depend on a base by handle or batch index
+        if (info.pNext || (info.flags & VK_PIPELINE_CREATE_DERIVATIVE_BIT))
+            return {};
+        VknHasher hasher{};
+        hasher.add(info.flags);
+        for (uint_fast32_t part = 0; part < NUM_PIPELINE_PARTS; ++part)
+        {
+            VknHash partHash{this->hashGfxPipelinePart(info, static_cast<VknPipelinePart>(part))};
+            if (!partHash)
+                return {};
+            hasher.add(partHash);
+        }
+        VknHash hash{hasher.get()};
+        return hash ? hash : VknHash{0u, 1u}; // 0 is reserved for unshareable
+    }
+
+    VknHash VknInfos::hashGfxPipelinePart(VkGraphicsPipelineCreateInfo &info, VknPipelinePart part)
+    {
+        VknHasher hasher{};
+        hasher.add(part);
+
+        // Every part is given all dynamic states and ignores those of other parts
+        hasher.add(info.pDynamicState != nullptr);
+        if (info.pDynamicState)
+        {
+            const VkPipelineDynamicStateCreateInfo &dynamic{*info.pDynamicState};
+            if (dynamic.pNext)
+                return {};
+            hasher.add(dynamic.flags);
+            hasher.addArray(dynamic.pDynamicStates, dynamic.dynamicStateCount);
+        }
+        // Ignored by Vulkan when dynamic, so pipelines differing only in them are shared
+        auto isDynamic = [&info](VkDynamicState state)
+        {
+            if (!info.pDynamicState)
+                return false;
+            const VkDynamicState *states{info.pDynamicState->pDynamicStates};
+            return std::find(states, states + info.pDynamicState->dynamicStateCount, state) !=
+                   states + info.pDynamicState->dynamicStateCount;
+        };
+        bool dynamicViewports{isDynamic(VK_DYNAMIC_STATE_VIEWPORT)};
+        bool dynamicScissors{isDynamic(VK_DYNAMIC_STATE_SCISSOR)};
+
+        if (part != VERTEX_INPUT_PART)
+        {
+            auto renderpass = m_renderpassHashes.find(info.renderPass);
+            if (renderpass == m_renderpassHashes.end())
+                return {};
+            hasher.add(renderpass->second, info.subpass);
+        }
+        if (part == PRE_RASTERIZATION_PART || part == FRAGMENT_SHADER_PART)
+        {
+            auto layout = m_pipelineLayoutHashes.find(info.layout);
+            if (layout == m_pipelineLayoutHashes.end())
+                return {};
+            hasher.add(layout->second);
+            for (uint_fast32_t i = 0; i < info.stageCount; ++i)
+            {
+                const VkPipelineShaderStageCreateInfo &stage{info.pStages[i]};
+                if ((stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) != (part == FRAGMENT_SHADER_PART))
+                    continue; // Belongs to the other shader part
+                auto module = m_shaderModuleHashes.find(stage.module);
+                if (stage.pNext || module == m_shaderModuleHashes.end())
+                    return {};
+                hasher.add(stage.flags, stage.stage, module->second);
+                hasher.addString(stage.pName);
+                hasher.add(stage.pSpecializationInfo != nullptr);
+                if (stage.pSpecializationInfo)
+                {
+                    const VkSpecializationInfo &specialization{*stage.pSpecializationInfo};
+                    hasher.addArray(specialization.pMapEntries, specialization.mapEntryCount);
+                    hasher.addArray(static_cast<const char *>(specialization.pData), specialization.dataSize);
+                }
+            }
+        }
+
+        // Each adds one state block and is false if the block can't be hashed
+        auto addVertexInput = [&hasher, &info]()
+        {
+            hasher.add(info.pVertexInputState != nullptr);
+            if (!info.pVertexInputState)
+                return true;
+            const VkPipelineVertexInputStateCreateInfo &vertexInput{*info.pVertexInputState};
+            hasher.add(vertexInput.flags);
+            hasher.addArray(vertexInput.pVertexBindingDescriptions, vertexInput.vertexBindingDescriptionCount);
+            hasher.addArray(vertexInput.pVertexAttributeDescriptions, vertexInput.vertexAttributeDescriptionCount);
+            return !vertexInput.pNext;
+        };
+        auto topologyClass = [](VkPrimitiveTopology topology)
+        {
+            switch (topology)
+            {
+            case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+                return 0u;
+            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+                return 1u;
+            case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+                return 3u;
+            default:
+                return 2u; // Triangles
+            }
+        };
+        auto addInputAssembly = [&hasher, &info, &isDynamic, &topologyClass]()
+        {
+            hasher.add(info.pInputAssemblyState != nullptr);
+            if (!info.pInputAssemblyState)
+                return true;
+            const VkPipelineInputAssemblyStateCreateInfo &inputAssembly{*info.pInputAssemblyState};
+            hasher.add(inputAssembly.flags);
+            if (isDynamic(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT))
+                hasher.add(topologyClass(inputAssembly.topology)); // A dynamic topology must stay in its class
+            else
+                hasher.add(inputAssembly.topology);
+            if (!isDynamic(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT))
+                hasher.add(inputAssembly.primitiveRestartEnable);
+            return !inputAssembly.pNext;
+        };
+        auto addTessellation = [&hasher, &info]()
+        {
+            hasher.add(info.pTessellationState != nullptr);
+            if (!info.pTessellationState)
+                return true;
+            const VkPipelineTessellationStateCreateInfo &tessellation{*info.pTessellationState};
+            hasher.add(tessellation.flags, tessellation.patchControlPoints);
+            return !tessellation.pNext;
+        };
+        auto addViewport = [&hasher, &info, dynamicViewports, dynamicScissors]()
+        {
+            hasher.add(info.pViewportState != nullptr);
+            if (!info.pViewportState)
+                return true;
+            // Ignored by Vulkan when dynamic, and skipping them lets pipelines survive a resize unchanged
+            const VkPipelineViewportStateCreateInfo &viewport{*info.pViewportState};
+            hasher.add(viewport.flags, viewport.viewportCount, viewport.scissorCount);
+            if (!dynamicViewports)
+                hasher.addArray(viewport.pViewports, viewport.viewportCount);
+            if (!dynamicScissors)
+                hasher.addArray(viewport.pScissors, viewport.scissorCount);
+            return !viewport.pNext;
+        };
+        auto addRasterization = [&hasher, &info, &isDynamic]()
+        {
+            hasher.add(info.pRasterizationState != nullptr);
+            if (!info.pRasterizationState)
+                return true;
+            const VkPipelineRasterizationStateCreateInfo &rasterization{*info.pRasterizationState};
+            hasher.add(rasterization.flags, rasterization.depthClampEnable, rasterization.rasterizerDiscardEnable,
+                       rasterization.depthBiasConstantFactor, rasterization.depthBiasClamp,
+                       rasterization.depthBiasSlopeFactor, rasterization.lineWidth);
+            if (!isDynamic(VK_DYNAMIC_STATE_POLYGON_MODE_EXT))
+                hasher.add(rasterization.polygonMode);
+            if (!isDynamic(VK_DYNAMIC_STATE_CULL_MODE_EXT))
+                hasher.add(rasterization.cullMode);
+            if (!isDynamic(VK_DYNAMIC_STATE_FRONT_FACE_EXT))
+                hasher.add(rasterization.frontFace);
+            if (!isDynamic(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT))
+                hasher.add(rasterization.depthBiasEnable);
+            return !rasterization.pNext;
+        };
+        auto addMultisample = [&hasher, &info]()
+        {
+            hasher.add(info.pMultisampleState != nullptr);
+            if (!info.pMultisampleState)
+                return true;
+            const VkPipelineMultisampleStateCreateInfo &multisample{*info.pMultisampleState};
+            hasher.add(multisample.flags, multisample.rasterizationSamples, multisample.sampleShadingEnable,
+                       multisample.minSampleShading, multisample.alphaToCoverageEnable, multisample.alphaToOneEnable);
+            hasher.addArray(multisample.pSampleMask, (multisample.rasterizationSamples + 31u) / 32u);
+            return !multisample.pNext;
+        };
+        auto addDepthStencil = [&hasher, &info]()
+        {
+            hasher.add(info.pDepthStencilState != nullptr);
+            if (!info.pDepthStencilState)
+                return true;
+            const VkPipelineDepthStencilStateCreateInfo &depthStencil{*info.pDepthStencilState};
+            hasher.add(depthStencil.flags, depthStencil.depthTestEnable, depthStencil.depthWriteEnable,
+                       depthStencil.depthCompareOp, depthStencil.depthBoundsTestEnable, depthStencil.stencilTestEnable,
+                       depthStencil.front, depthStencil.back, depthStencil.minDepthBounds, depthStencil.maxDepthBounds);
+            return !depthStencil.pNext;
+        };
+        auto addColorBlend = [&hasher, &info]()
+        {
+            hasher.add(info.pColorBlendState != nullptr);
+            if (!info.pColorBlendState)
+                return true;
+            const VkPipelineColorBlendStateCreateInfo &colorBlend{*info.pColorBlendState};
+            hasher.add(colorBlend.flags, colorBlend.logicOpEnable, colorBlend.logicOp, colorBlend.blendConstants);
+            hasher.addArray(colorBlend.pAttachments, colorBlend.attachmentCount);
+            return !colorBlend.pNext;
+        };
+
+        bool hashable{false};
+        switch (part)
+        {
+        case VERTEX_INPUT_PART:
+            hashable = addVertexInput() && addInputAssembly();
+            break;
+        case PRE_RASTERIZATION_PART:
+            hashable = addTessellation() && addViewport() && addRasterization();
+            break;
+        case FRAGMENT_SHADER_PART:
+            hashable = addMultisample() && addDepthStencil();
+            break;
+        case FRAGMENT_OUTPUT_PART:
+            hashable = addMultisample() && addColorBlend();
+            break;
+        default:
+            throw std::runtime_error("Invalid pipeline part.");
+        }
+        if (!hashable)
+            return {};
+        VknHash hash{hasher.get()};
+        return hash ? hash : VknHash{0u, 1u};
+    }
     /*
         VmaAllocationInfo *VknInfos::fileVmaAllocationInfo(VknIdxs &relIdxs, uint32_t memoryType, VkDeviceMemory deviceMemory, VkDeviceSize offset, VkDeviceSize size,
                                                            void *pMappedData, void *pUserData, const char *pName)
@@ -26,5 +26,6 @@ namespace vkn
         delete s_infos;
         s_engine = nullptr;
         s_infos = nullptr;
+        VknTrace::disable(); // Teardown is traced by now, so a trace still recording is written here
     }
 }
\ No newline at end of file
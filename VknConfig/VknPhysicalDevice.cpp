@@ -214,6 +214,65 @@ namespace vkn
         return &s_properties(m_relIdxs.get<VkPhysicalDevice>()).limits;
     }
 
+    bool VknPhysicalDevice::supportsExtension(const char *name)
+    {
+        uint32_t extensionCount{0};
+        VknResult res{
+            vkEnumerateDeviceExtensionProperties(*this->getVkPhysicalDevice(), nullptr, &extensionCount, nullptr),
+            "Count device extensions"};
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        res = vkEnumerateDeviceExtensionProperties(
+            *this->getVkPhysicalDevice(), nullptr, &extensionCount, extensions.data());
+        for (uint_fast32_t i = 0; i < extensionCount; ++i)
+            if (std::strcmp(extensions[i].extensionName, name) == 0)
+                return true;
+        return false;
+    }
+
+    bool VknPhysicalDevice::supportsGraphicsPipelineLibrary()
+    {
+        if (!this->supportsExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) ||
+            !this->supportsExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+            return false;
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT library{};
+        library.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &library;
+        vkGetPhysicalDeviceFeatures2(*this->getVkPhysicalDevice(), &features);
+        return library.graphicsPipelineLibrary == VK_TRUE;
+    }
+
+    VknExtendedDynamicState VknPhysicalDevice::getExtendedDynamicStateSupport()
+    {
+        if (!this->supportsExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+            return EXTENDED_DYNAMIC_STATE_NONE;
+        bool hasExtension2{this->supportsExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)};
+        bool hasExtension3{hasExtension2 && this->supportsExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)};
+
+        // Only structs of supported extensions are chained
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT dynamicState3{};
+        dynamicState3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT dynamicState2{};
+        dynamicState2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+        dynamicState2.pNext = hasExtension3 ? &dynamicState3 : nullptr;
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        dynamicState.pNext = hasExtension2 ? &dynamicState2 : nullptr;
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &dynamicState;
+        vkGetPhysicalDeviceFeatures2(*this->getVkPhysicalDevice(), &features);
+
+        if (dynamicState.extendedDynamicState != VK_TRUE)
+            return EXTENDED_DYNAMIC_STATE_NONE;
+        if (!hasExtension2 || dynamicState2.extendedDynamicState2 != VK_TRUE)
+            return EXTENDED_DYNAMIC_STATE_1;
+        if (!hasExtension3 || dynamicState3.extendedDynamicState3PolygonMode != VK_TRUE)
+            return EXTENDED_DYNAMIC_STATE_2;
+        return EXTENDED_DYNAMIC_STATE_3;
+    }
+
     VkPhysicalDevice *VknPhysicalDevice::getVkPhysicalDevice()
     {
         if (!m_selectedPhysicalDevice)
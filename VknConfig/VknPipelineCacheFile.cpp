@@ -0,0 +1,74 @@
+#include "include/VknPipelineCacheFile.hpp"
+
+namespace vkn
+{
+    std::filesystem::path VknPipelineCacheFile::keyedPath(const std::filesystem::path &directory,
+                                                          const VkPhysicalDeviceProperties &properties)
+    {
+        static const char *hexDigits{"0123456789abcdef"};
+        std::string uuid{};
+        for (uint_fast32_t i = 0; i < VK_UUID_SIZE; ++i)
+        {
+            uuid += hexDigits[properties.pipelineCacheUUID[i] >> 4];
+            uuid += hexDigits[properties.pipelineCacheUUID[i] & 0xF];
+        }
+        return directory / (std::to_string(properties.vendorID) + "-" + std::to_string(properties.deviceID) + "-" +
+                            std::to_string(properties.driverVersion) + "-" + uuid + ".bin");
+    }
+
+    std::vector<char> VknPipelineCacheFile::load(const std::filesystem::path &path,
+                                                 const VkPhysicalDeviceProperties &properties)
+    {
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (!file)
+            return {};
+        std::vector<char> blob(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(blob.data(), blob.size()))
+            return {};
+
+        // Drivers reject foreign blobs themselves, but not all of them safely
+        VkPipelineCacheHeaderVersionOne header{};
+        if (blob.size() < sizeof(header))
+            return {};
+        std::memcpy(&header, blob.data(), sizeof(header));
+        if (header.headerSize < sizeof(header) || header.headerSize > blob.size() ||
+            header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+            header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+            std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+            return {};
+        return blob;
+    }
+
+    bool VknPipelineCacheFile::save(VkDevice device, VkPipelineCache cache, const std::filesystem::path &path)
+    {
+        size_t size{0};
+        if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0)
+            return false;
+        std::vector<char> blob(size);
+        if (vkGetPipelineCacheData(device, cache, &size, blob.data()) != VK_SUCCESS)
+            return false;
+
+        std::error_code error{};
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), error);
+        std::filesystem::path temp{path};
+        temp += ".tmp";
+        {
+            std::ofstream file{temp, std::ios::binary | std::ios::trunc};
+            if (!file.write(blob.data(), size) || !file.flush())
+            {
+                file.close();
+                std::filesystem::remove(temp, error);
+                return false;
+            }
+        }
+        std::filesystem::rename(temp, path, error); // Replaces path in one step
+        if (error)
+        {
+            std::filesystem::remove(temp, error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -38,11 +38,11 @@ namespace vkn
             m_relIdxs, s_engine->getVectorSlice<VkDescriptorSetLayout>(m_descriptorSetLayoutStartIdx, m_descriptorSetLayouts.size()),
             m_pushConstantRanges, m_createFlags);
 
-        VknResult res{
-            vkCreatePipelineLayout(
-                s_engine->getObject<VkDevice>(m_absIdxs), createInfo,
-                nullptr, &s_engine->getObject<VkPipelineLayout>(m_absIdxs)),
-            "Create pipeline layout."};
+        VknResult res{"Create pipeline layout.", this->traceArgs<VkPipelineLayout>()};
+        res = vkCreatePipelineLayout(
+            s_engine->getObject<VkDevice>(m_absIdxs), createInfo,
+            nullptr, &s_engine->getObject<VkPipelineLayout>(m_absIdxs));
+        s_infos->hashPipelineLayout(s_engine->getObject<VkPipelineLayout>(m_absIdxs), *createInfo);
         m_createdPipelineLayout = true;
     }
 
@@ -35,11 +35,12 @@ namespace vkn
         if (m_createdRenderpass)
             throw std::runtime_error("Renderpass already created.");
         VkRenderPassCreateInfo *createInfo = s_infos->fileRenderpassCreateInfo(m_relIdxs, 0); // Flags not used ever
-        VknResult res{vkCreateRenderPass(
-                          s_engine->getObject<VkDevice>(m_absIdxs),
-                          createInfo, VK_NULL_HANDLE,
-                          &s_engine->getObject<VkRenderPass>(m_absIdxs)),
-                      "Create renderpass."};
+        VknResult res{"Create renderpass.", this->traceArgs<VkRenderPass>()};
+        res = vkCreateRenderPass(
+            s_engine->getObject<VkDevice>(m_absIdxs),
+            createInfo, VK_NULL_HANDLE,
+            &s_engine->getObject<VkRenderPass>(m_absIdxs));
+        s_infos->hashRenderpass(s_engine->getObject<VkRenderPass>(m_absIdxs), *createInfo);
         m_createdRenderpass = true;
     }
 
@@ -82,16 +83,11 @@ namespace vkn
         uint32_t subpassIdx, uint32_t attachIdx, VknAttachmentType attachmentType,
         VkImageLayout attachmentRefLayout)
     {
-        auto *subpassRefs = s_infos->getSubpassAttachmentReferences(
-            m_relIdxs.get<VkDevice>(), m_relIdxs.get<VkRenderPass>(), subpassIdx);
         if (!m_numPreserveRefs.exists(subpassIdx))
             m_numPreserveRefs.insert(subpassIdx, 0u);
         if (m_numAttachRefs[subpassIdx].getDataSize() == 0)
             for (size_t i = 0; i < NUM_ATTACHMENT_TYPES; ++i)
-            {
                 m_numAttachRefs[subpassIdx].insert(0u, i);
-                subpassRefs->getSubspace(i);
-            }
 
         uint32_t refIdx{0};
         if (attachmentType == PRESERVE_ATTACHMENT)
@@ -106,6 +102,31 @@ namespace vkn
     }
 
     void VknRenderpass::createPipelines()
+    {
+        this->buildPipelines(false);
+    }
+
+    void VknRenderpass::createPipelinesAsync()
+    {
+        this->buildPipelines(true);
+    }
+
+    void VknRenderpass::waitForPipelines()
+    {
+        std::shared_future<void> build{std::move(m_pipelineBuild)};
+        m_pipelineBuild = {};
+        if (build.valid())
+            build.get(); // Rethrows what the build threw
+    }
+
+    void VknRenderpass::checkPipelineBuild()
+    {
+        if (m_pipelineBuild.valid() &&
+            m_pipelineBuild.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+            this->waitForPipelines();
+    }
+
+    void VknRenderpass::buildPipelines(bool async)
     {
         if (!m_createdRenderpass)
             throw std::runtime_error("Renderpass not created before creating pipelines.");
@@ -116,8 +137,9 @@ namespace vkn
                 if (!shaderStage.isShaderModuleCreated())
                     throw std::runtime_error("Shader module in shader stage not created before pipelines created.");
 
-        VkPipeline *vkPipelines =
-            s_engine->getVectorSlice<VkPipeline>(m_pipelineStartAbsIdx, m_numSubpasses).getData();
+        // Only the size is kept, registrations on other threads may move the engine's storage
+        if (s_engine->getVectorSlice<VkPipeline>(m_pipelineStartAbsIdx, m_numSubpasses).getSpan().size() != m_numSubpasses)
+            throw std::runtime_error("Pipeline slots not allocated before creating pipelines.");
         for (auto &pipeline : m_pipelines)
         {
             if (m_recreatingPipelines)
@@ -130,6 +152,8 @@ namespace vkn
                 pipeline.getRasterizationState()->_fileRasterizationStateCreateInfo();
                 pipeline.getViewportState()->_fileViewportStateCreateInfo();
                 pipeline.getColorBlendState()->_fileColorBlendStateCreateInfo();
+                if (m_extendedDynamicState != EXTENDED_DYNAMIC_STATE_NONE)
+                    pipeline.getDynamicState()->_addExtendedDynamicStates(m_extendedDynamicState);
                 pipeline.getDynamicState()->_fileDynamicStateCreateInfo();
                 pipeline.getPipelineLayout()->_createPipelineLayout();
                 for (auto &shaderstage : *pipeline.getShaderStages())
@@ -137,17 +161,246 @@ namespace vkn
             }
             pipeline._filePipelineCreateInfo();
         }
-        VknSpace<VkGraphicsPipelineCreateInfo> *pipelineCreateInfos{
-            s_infos->getPipelineCreateInfos(m_relIdxs)};
-        VknResult res{vkCreateGraphicsPipelines(
-                          s_engine->getObject<VkDevice>(m_absIdxs),
-                          VK_NULL_HANDLE, m_numSubpasses,
-                          pipelineCreateInfos->getData(), nullptr,
-                          vkPipelines),
-                      "Create pipeline."};
+        VkGraphicsPipelineCreateInfo *pipelineCreateInfos{s_infos->getPipelineCreateInfos(m_relIdxs)->getData()};
+        VkDevice device{s_engine->getObject<VkDevice>(m_absIdxs)};
+
+        // Derivatives may name their base by index into this batch, so a batch with any is created whole
+        bool indexedBases{std::any_of(
+            pipelineCreateInfos, pipelineCreateInfos + m_numSubpasses,
+            [](const VkGraphicsPipelineCreateInfo &info)
+            { return (info.flags & VK_PIPELINE_CREATE_DERIVATIVE_BIT) && info.basePipelineIndex >= 0; })};
+
+        // Pipelines already created with the same content, here or in another renderpass, are shared. Only
+        // the first of several identical misses is created.
+        std::vector<VknHash> hashes(m_numSubpasses);
+        std::vector<VkGraphicsPipelineCreateInfo> missInfos{};
+        std::vector<uint32_t> missSubpasses{};
+        for (uint32_t i = 0; i < m_numSubpasses; ++i)
+        {
+            if (!indexedBases)
+                hashes[i] = s_infos->hashGfxPipeline(pipelineCreateInfos[i]);
+            VkPipeline found{hashes[i] ? s_engine->findPipeline(device, hashes[i]) : VK_NULL_HANDLE};
+            s_engine->setObject<VkPipeline>(this->getPipeline(i)->getAbsIdxs(), found);
+            if (found != VK_NULL_HANDLE)
+            {
+                this->getPipeline(i)->_setReady(true);
+                continue;
+            }
+            if (hashes[i] && std::find(hashes.begin(), hashes.begin() + i, hashes[i]) != hashes.begin() + i)
+                continue; // Shares the earlier miss once it's created
+            missInfos.push_back(pipelineCreateInfos[i]);
+            missSubpasses.push_back(i);
+        }
+
+        // Misses are linked from library parts only if every one of them is shareable
+        bool linkable{m_usePipelineLibrary && !indexedBases};
+        std::vector<VknPipelinePartHashes> missParts{};
+        for (uint_fast32_t i = 0; linkable && i < missSubpasses.size(); ++i)
+        {
+            linkable = static_cast<bool>(hashes[missSubpasses[i]]); // Then no part hash is 0 either
+            VknPipelinePartHashes &parts{missParts.emplace_back()};
+            for (uint_fast32_t part = 0; linkable && part < NUM_PIPELINE_PARTS; ++part)
+                parts[part] = s_infos->hashGfxPipelinePart(
+                    pipelineCreateInfos[missSubpasses[i]], static_cast<VknPipelinePart>(part));
+        }
+        if (!linkable)
+            missParts.clear();
+
+        // Everything above stays on this thread, the infos and registry lookups aren't shared with the build.
+        // Each handle is written before its pipeline reports ready.
+        auto publish = [this, device, indexedBases, hashes = std::move(hashes), missInfos = std::move(missInfos),
+                        missSubpasses = std::move(missSubpasses), missParts = std::move(missParts)]()
+        {
+            std::vector<VkPipeline> created(missInfos.size(), VK_NULL_HANDLE);
+            if (!missInfos.empty())
+                this->compilePipelines(device, missInfos, created, !indexedBases, missParts);
+            for (uint_fast32_t i = 0; i < created.size(); ++i)
+            {
+                VknPipeline *pipeline{this->getPipeline(missSubpasses[i])};
+                VkPipeline published{created[i]};
+                if (hashes[missSubpasses[i]])
+                    published = s_engine->registerPipeline(device, hashes[missSubpasses[i]], created[i]);
+                if (published != created[i]) // Another build created the same pipeline meanwhile
+                    vkDestroyPipeline(device, created[i], nullptr);
+                s_engine->setObject<VkPipeline>(pipeline->getAbsIdxs(), published);
+                pipeline->_setReady(true);
+            }
+            for (auto &pipeline : m_pipelines)
+                if (!pipeline.isReady()) // Identical to a miss created above
+                {
+                    s_engine->setObject<VkPipeline>(
+                        pipeline.getAbsIdxs(), s_engine->findPipeline(device, hashes[pipeline.getRelIdxs().get<VkPipeline>()]));
+                    pipeline._setReady(true);
+                }
+        };
+        if (async)
+        {
+            m_pipelineBuild = std::async(std::launch::async, std::move(publish)).share();
+            s_engine->addDeviceWork(device, m_pipelineBuild);
+        }
+        else
+            publish();
         m_createdPipelines = true;
     }
 
+    void VknRenderpass::compilePipelines(VkDevice device, std::span<const VkGraphicsPipelineCreateInfo> infos,
+                                         std::span<VkPipeline> pipelines, bool splittable,
+                                         std::span<const VknPipelinePartHashes> parts)
+    {
+        // The cache is internally synchronized, so every worker shares it
+        VkPipelineCache cache{s_engine->getPipelineCache(&s_engine->getObject<VkDevice>(m_absIdxs))};
+        auto compile = [this, device, cache, infos, pipelines, parts](uint_fast32_t first, uint_fast32_t count)
+        {
+            if (!parts.empty())
+            {
+                for (uint_fast32_t i = first; i < first + count; ++i)
+                    pipelines[i] = this->linkPipeline(device, cache, infos[i], parts[i]);
+                return;
+            }
+            VknResult res{"Create pipeline.", this->traceArgs<VkPipeline>()};
+            res = vkCreateGraphicsPipelines(device, cache, static_cast<uint32_t>(count), infos.data() + first,
+                                            nullptr, pipelines.data() + first);
+        };
+
+        uint_fast32_t numInfos{static_cast<uint_fast32_t>(infos.size())};
+        uint_fast32_t numWorkers{m_maxPipelineThreads ? m_maxPipelineThreads : std::thread::hardware_concurrency()};
+        numWorkers = splittable ? std::min(numWorkers, numInfos) : 1u;
+        if (numWorkers < 1u) // When hardware_concurrency() is unknown
+            numWorkers = 1u;
+
+        std::vector<std::exception_ptr> errors(numWorkers);
+        auto guarded = [&compile, &errors](uint_fast32_t worker, uint_fast32_t first, uint_fast32_t count)
+        {
+            try
+            {
+                compile(first, count);
+            }
+            catch (...)
+            {
+                errors[worker] = std::current_exception();
+            }
+        };
+        if (numWorkers == 1u)
+            guarded(0u, 0u, numInfos);
+        else
+        {
+            // Contiguous chunks, the first few one pipeline longer
+            std::vector<std::thread> workers{};
+            workers.reserve(numWorkers);
+            uint_fast32_t first{0};
+            for (uint_fast32_t i = 0; i < numWorkers; ++i)
+            {
+                uint_fast32_t count{numInfos / numWorkers + (i < numInfos % numWorkers ? 1u : 0u)};
+                workers.emplace_back(guarded, i, first, count);
+                first += count;
+            }
+            for (auto &worker : workers)
+                worker.join();
+        }
+        for (auto &error : errors)
+            if (error)
+            {
+                // Failed creates leave null handles, pipelines created before the failure would leak
+                for (VkPipeline pipeline : pipelines)
+                    if (pipeline != VK_NULL_HANDLE)
+                        vkDestroyPipeline(device, pipeline, nullptr);
+                std::rethrow_exception(error);
+            }
+    }
+
+    VkPipeline VknRenderpass::linkPipeline(VkDevice device, VkPipelineCache cache,
+                                           const VkGraphicsPipelineCreateInfo &info,
+                                           const VknPipelinePartHashes &parts)
+    {
+        std::array<VkPipeline, NUM_PIPELINE_PARTS> libraries{};
+        for (uint_fast32_t part = 0; part < NUM_PIPELINE_PARTS; ++part)
+        {
+            libraries[part] = s_engine->findPipelineLibrary(device, parts[part]);
+            if (libraries[part] != VK_NULL_HANDLE)
+                continue;
+            VkPipeline library{this->compilePipelinePart(device, cache, info, static_cast<VknPipelinePart>(part))};
+            libraries[part] = s_engine->registerPipelineLibrary(device, parts[part], library);
+            if (libraries[part] != library) // Another worker compiled the same part first
+                vkDestroyPipeline(device, library, nullptr);
+        }
+
+        // Without link time optimization, so linking only stitches the compiled parts together
+        VkPipelineLibraryCreateInfoKHR libraryInfo{};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryInfo.libraryCount = NUM_PIPELINE_PARTS;
+        libraryInfo.pLibraries = libraries.data();
+        VkGraphicsPipelineCreateInfo linkInfo{};
+        linkInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        linkInfo.pNext = &libraryInfo;
+        linkInfo.layout = info.layout;
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        VknResult res{"Link pipeline.", this->traceArgs<VkPipeline>()};
+        res = vkCreateGraphicsPipelines(device, cache, 1u, &linkInfo, nullptr, &pipeline);
+        return pipeline;
+    }
+
+    VkPipeline VknRenderpass::compilePipelinePart(VkDevice device, VkPipelineCache cache,
+                                                  const VkGraphicsPipelineCreateInfo &info, VknPipelinePart part)
+    {
+        static constexpr std::array<VkGraphicsPipelineLibraryFlagsEXT, NUM_PIPELINE_PARTS> partFlags{
+            VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT};
+        VkGraphicsPipelineLibraryCreateInfoEXT partInfo{};
+        partInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        partInfo.flags = partFlags[part];
+
+        // Only the state hashGfxPipelinePart() hashed for this part, plus the dynamic states
+        VkGraphicsPipelineCreateInfo partCreateInfo{};
+        partCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        partCreateInfo.pNext = &partInfo;
+        partCreateInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+        partCreateInfo.pDynamicState = info.pDynamicState;
+        std::vector<VkPipelineShaderStageCreateInfo> stages{};
+        if (part != VERTEX_INPUT_PART)
+        {
+            partCreateInfo.renderPass = info.renderPass;
+            partCreateInfo.subpass = info.subpass;
+        }
+        if (part == PRE_RASTERIZATION_PART || part == FRAGMENT_SHADER_PART)
+        {
+            partCreateInfo.layout = info.layout;
+            for (uint_fast32_t i = 0; i < info.stageCount; ++i)
+                if ((info.pStages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT) == (part == FRAGMENT_SHADER_PART))
+                    stages.push_back(info.pStages[i]);
+            partCreateInfo.stageCount = static_cast<uint32_t>(stages.size());
+            partCreateInfo.pStages = stages.data();
+        }
+        switch (part)
+        {
+        case VERTEX_INPUT_PART:
+            partCreateInfo.pVertexInputState = info.pVertexInputState;
+            partCreateInfo.pInputAssemblyState = info.pInputAssemblyState;
+            break;
+        case PRE_RASTERIZATION_PART:
+            partCreateInfo.pTessellationState = info.pTessellationState;
+            partCreateInfo.pViewportState = info.pViewportState;
+            partCreateInfo.pRasterizationState = info.pRasterizationState;
+            break;
+        case FRAGMENT_SHADER_PART:
+            partCreateInfo.pMultisampleState = info.pMultisampleState;
+            partCreateInfo.pDepthStencilState = info.pDepthStencilState;
+            break;
+        case FRAGMENT_OUTPUT_PART:
+            partCreateInfo.pMultisampleState = info.pMultisampleState;
+            partCreateInfo.pColorBlendState = info.pColorBlendState;
+            break;
+        default:
+            throw std::runtime_error("Invalid pipeline part.");
+        }
+
+        VkPipeline library{VK_NULL_HANDLE};
+        VknResult res{"Create pipeline library.", this->traceArgs<VkPipeline>()};
+        res = vkCreateGraphicsPipelines(device, cache, 1u, &partCreateInfo, nullptr, &library);
+        return library;
+    }
+
     void VknRenderpass::addSubpass(
         uint32_t subpassIdx, bool isCompute, VkPipelineBindPoint pipelineBindPoint,
         VkSubpassDescriptionFlags flags)
@@ -193,14 +446,15 @@ namespace vkn
 
     void VknRenderpass::recreatePipelines(VknSwapchain &swapchain, uint32_t viewportIdx, uint32_t scissorIdx)
     {
+        this->waitForPipelines(); // An async build still reads the infos removed below
         m_recreatingPipelines = true;
         for (auto &pipeline : m_pipelines)
         {
             s_infos->removePipelineCreateInfo(pipeline.getRelIdxs());
-            vkDestroyPipeline(
-                s_engine->getObject<VkDevice>(m_absIdxs),
-                s_engine->getObject<VkPipeline>(pipeline.getAbsIdxs()),
-                nullptr);
+            VkPipeline vkPipeline{s_engine->getObject<VkPipeline>(pipeline.getAbsIdxs())};
+            if (s_engine->releasePipeline(vkPipeline)) // Still in use elsewhere if shared
+                vkDestroyPipeline(s_engine->getObject<VkDevice>(m_absIdxs), vkPipeline, nullptr);
+            pipeline._setReady(false);
             VknViewportState *viewport = pipeline.getViewportState();
             viewport->removeCreateInfo();
             viewport->removeScissors();
@@ -4,8 +4,14 @@ namespace vkn
 {
     VknArchive<VknResult> VknResult::s_archive = VknArchive<VknResult>{};
 
-    VknResult::VknResult(std::string opDesc) : m_opDesc{opDesc}
+    VknResult::VknResult(std::string opDesc, std::string traceArgs) : m_opDesc{opDesc}
     {
+        if (!traceArgs.empty() && VknTrace::isEnabled())
+        {
+            m_traceArgs = traceArgs;
+            m_traceBegin = VknTrace::now();
+            m_traced = true;
+        }
     }
 
     VknResult::VknResult(VkResult result, std::string opDesc)
@@ -16,6 +22,11 @@ namespace vkn
 
     void VknResult::evaluate(VkResult result)
     {
+        if (m_traced)
+        {
+            VknTrace::record(m_opDesc, "create", m_traceBegin, VknTrace::now(), m_traceArgs);
+            m_traced = false;
+        }
         if (result != VK_SUCCESS)
             throw std::runtime_error(this->toErr("Error: "));
         m_result = result;
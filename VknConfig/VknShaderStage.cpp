@@ -75,11 +75,11 @@ namespace vkn
 #endif
         VkShaderModuleCreateInfo *shaderModuleCreateInfo =
             s_infos->fileShaderModuleCreateInfo(m_relIdxs, &m_code);
-        VknResult res{
-            vkCreateShaderModule(s_engine->getObject<VkDevice>(m_absIdxs),
-                                 shaderModuleCreateInfo, VK_NULL_HANDLE,
-                                 &s_engine->getObject<VkShaderModule>(m_absIdxs)),
-            "Create shader module."};
+        VknResult res{"Create shader module.", this->traceArgs<VkShaderModule>()};
+        res = vkCreateShaderModule(s_engine->getObject<VkDevice>(m_absIdxs),
+                                   shaderModuleCreateInfo, VK_NULL_HANDLE,
+                                   &s_engine->getObject<VkShaderModule>(m_absIdxs));
+        s_infos->hashShaderModule(s_engine->getObject<VkShaderModule>(m_absIdxs), *shaderModuleCreateInfo);
         m_createdShaderModule = true;
     }
 
@@ -170,11 +170,10 @@ namespace vkn
         this->fileSwapchainCreateInfo();
         VkSwapchainCreateInfoKHR *createInfo{
             s_infos->getSwapchainCreateInfo(m_relIdxs)};
-        VknResult res{
-            vkCreateSwapchainKHR(s_engine->getObject<VkDevice>(m_absIdxs),
-                                 createInfo, nullptr,
-                                 &s_engine->getObject<VkSwapchainKHR>(m_absIdxs)),
-            "Create swapchain"};
+        VknResult res{"Create swapchain", this->traceArgs<VkSwapchainKHR>()};
+        res = vkCreateSwapchainKHR(s_engine->getObject<VkDevice>(m_absIdxs),
+                                   createInfo, nullptr,
+                                   &s_engine->getObject<VkSwapchainKHR>(m_absIdxs));
 
         m_createdSwapchain = true;
 
@@ -262,12 +261,16 @@ namespace vkn
 
     void VknSwapchain::demolishSwapchain()
     {
-        m_vkSwapchainImages.clear();
         vkDestroySwapchainKHR(
             s_engine->getObject<VkDevice>(m_absIdxs),
             s_engine->getObject<VkSwapchainKHR>(m_absIdxs),
             nullptr);
+        this->resetCreationState();
+    }
 
+    void VknSwapchain::resetCreationState()
+    {
+        m_vkSwapchainImages.clear();
         m_setImageDimensions = false;
         m_setImageCount = false;
 
@@ -281,7 +284,25 @@ namespace vkn
 
     void VknSwapchain::recreateSwapchain()
     {
-        this->demolishSwapchain();
+        // The old swapchain may still be presenting, so it's handed to the new one and retired instead
+        VkDevice device{s_engine->getObject<VkDevice>(m_absIdxs)};
+        VkSwapchainKHR oldSwapchain{*this->getVkSwapchain()};
+        this->resetCreationState();
+
+        // The image count is kept, sync objects, command buffers and framebuffers are all sized by it
+        VkSurfaceCapabilitiesKHR capabilities{};
+        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+            s_engine->getObject<VkPhysicalDevice>(m_absIdxs),
+            s_engine->getObject<VkSurfaceKHR>(m_surfaceIdx.value()),
+            &capabilities);
+        if (s_maxFramesInFlight < capabilities.minImageCount ||
+            (capabilities.maxImageCount > 0 && s_maxFramesInFlight > capabilities.maxImageCount))
+            throw std::runtime_error("Surface no longer supports the swapchain's image count.");
+        m_setImageCount = true;
+
+        this->setOldSwapchain(oldSwapchain);
         this->createSwapchain();
+        s_engine->retire(device, [device, oldSwapchain]()
+                         { vkDestroySwapchainKHR(device, oldSwapchain, nullptr); });
     }
 }
@@ -0,0 +1,103 @@
+#include "include/VknTrace.hpp"
+
+namespace vkn
+{
+    std::atomic<bool> VknTrace::s_enabled{false};
+    std::mutex VknTrace::s_lock{};
+    std::vector<VknTrace::VknTraceEvent> VknTrace::s_events{};
+    std::string VknTrace::s_path{};
+    std::atomic<std::chrono::steady_clock::rep> VknTrace::s_epoch{0};
+
+    void VknTrace::enable(std::string path)
+    {
+        std::scoped_lock lock{s_lock};
+        if (s_enabled)
+            throw std::runtime_error("Tracing already enabled.");
+        s_path = path;
+        s_events.clear();
+        s_epoch = std::chrono::steady_clock::now().time_since_epoch().count();
+        s_enabled = true;
+    }
+
+    bool VknTrace::disable()
+    {
+        std::vector<VknTraceEvent> events{};
+        std::string path{};
+        {
+            std::scoped_lock lock{s_lock};
+            if (!s_enabled)
+                return true;
+            s_enabled = false;
+            events = std::move(s_events);
+            s_events.clear();
+            path = std::move(s_path);
+        }
+
+        // Called from VknObject::exit(), so a failed write is reported, not thrown
+        std::ofstream file{path, std::ios::trunc};
+        if (!file)
+            return false;
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (uint_fast32_t i = 0; i < events.size(); ++i)
+        {
+            const VknTraceEvent &event{events[i]};
+            file << (i ? ",\n" : "\n") << "{\"name\":\"" << escape(event.name) << "\",\"cat\":\""
+                 << escape(event.category) << "\",\"ph\":\"X\",\"ts\":" << event.begin
+                 << ",\"dur\":" << event.end - event.begin << ",\"pid\":1,\"tid\":" << event.thread;
+            if (!event.args.empty())
+                file << ",\"args\":" << event.args;
+            file << "}";
+        }
+        file << "\n]}\n";
+        file.close();
+        return !file.fail();
+    }
+
+    uint_fast64_t VknTrace::now()
+    {
+        std::chrono::steady_clock::duration epoch{s_epoch.load()};
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch() - epoch)
+            .count();
+    }
+
+    void VknTrace::record(std::string name, std::string category, uint_fast64_t begin, uint_fast64_t end,
+                          std::string args)
+    {
+        static std::atomic<uint_fast32_t> s_nextThread{1};
+        thread_local uint_fast32_t thread{s_nextThread++}; // Small ids read better than hashed thread::ids
+        std::scoped_lock lock{s_lock};
+        if (s_enabled) // May have been disabled since the event began
+            s_events.push_back(VknTraceEvent{
+                std::move(name), std::move(category), begin, end, thread, std::move(args)});
+    }
+
+    std::string VknTrace::escape(const std::string &str)
+    {
+        std::string escaped{};
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    VknTraceScope::VknTraceScope(std::string name, std::string category, std::string args)
+    {
+        if (!VknTrace::isEnabled())
+            return;
+        m_name = std::move(name);
+        m_category = std::move(category);
+        m_args = std::move(args);
+        m_begin = VknTrace::now();
+        m_active = true;
+    }
+
+    VknTraceScope::~VknTraceScope()
+    {
+        if (m_active)
+            VknTrace::record(std::move(m_name), std::move(m_category), m_begin, VknTrace::now(), std::move(m_args));
+    }
+}
@@ -64,6 +64,8 @@ namespace vkn
 
         // State
         uint_fast32_t m_currentFrame = 0;
+        uint_fast64_t m_frameSerial{0};              // Number of frames submitted
+        std::vector<uint_fast64_t> m_fenceSerials{}; // Serial last submitted with each frame's fence
         uint_fast32_t m_imageIndex;
         std::vector<VkSemaphore> m_signalSemaphores;
         std::vector<VkFence *> m_imagesInFlight; // Fence for each swapchain image
@@ -1,11 +1,24 @@
 #pragma once
 
 #include <iterator>
+#include <algorithm>
 #include <vector>
 #include <filesystem>
 #include <list>
 #include <fstream>
 #include <string>
+#include <optional>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <span>
+#include <bit>
+#include <memory>
+#include <memory_resource>
+#include <compare>
 
 namespace vkn
 {
@@ -19,13 +32,184 @@ namespace vkn
     class VknIdxs;
     class VknInfos;
 
-    // Forward declaration for template friend class
-    template <typename IterDataType>
+    // Forward declarations carry the default position width (8-bit, up to 256 elements)
+    template <typename VecDataType, typename IdxType = uint_least8_t>
+    class VknVector;
+    template <typename IterDataType, typename IdxType = uint_least8_t>
     class VknVectorIterator;
 
+    // Limits of the default 8-bit VknVector, see VknVector::s_maxDataSize for other widths
     const uint_least16_t MAX_DATA_SIZE = 256u;
     const uint_least16_t MAX_POS = 255u;
 
+    // Linear memory_resource. Allocations bump through blocks taken from upstream, and deallocate() only
+    // gives back the most recent allocation. rewind() drops everything allocated after a mark but keeps the
+    // blocks, so refilling the same amount after a rewind makes no upstream calls.
+    class VknArena : public std::pmr::memory_resource
+    {
+        struct Block
+        {
+            std::byte *data;
+            size_t size;
+        };
+        static constexpr size_t s_maxBlockSize{size_t{1u} << 20u};
+
+        std::pmr::memory_resource *m_upstream;
+        std::vector<Block> m_blocks{};
+        size_t m_nextBlockSize;
+        size_t m_block{0u};          // Block being bumped through
+        size_t m_offset{0u};         // Into m_blocks[m_block]
+        std::byte *m_last{nullptr}; // Most recent allocation, the only one deallocate() can reclaim
+
+    public:
+        struct Marker
+        {
+            size_t block{0u};
+            size_t offset{0u};
+        };
+
+        explicit VknArena(size_t blockSize = 16384u,
+                          std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+            : m_upstream{upstream}, m_nextBlockSize{std::max<size_t>(blockSize, 64u)}
+        {
+        }
+        ~VknArena() { this->release(); }
+
+        VknArena(const VknArena &) = delete;
+        VknArena &operator=(const VknArena &) = delete;
+
+        Marker mark() const { return Marker{m_block, m_offset}; }
+
+        // Anything allocated after marker must no longer be in use
+        void rewind(Marker marker)
+        {
+            if (marker.block > m_block || (marker.block == m_block && marker.offset > m_offset))
+                throw std::runtime_error("Cannot rewind a VknArena forward.");
+            m_block = marker.block;
+            m_offset = marker.offset;
+            m_last = nullptr;
+        }
+
+        void reset() { this->rewind(Marker{}); }
+
+        // Returns every block upstream. Nothing allocated from the arena may still be in use.
+        void release()
+        {
+            for (Block &block : m_blocks)
+                m_upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+            m_blocks.clear();
+            this->rewind(Marker{});
+        }
+
+        uint_fast32_t getNumBlocks() const { return m_blocks.size(); }
+        size_t getBytesReserved() const
+        {
+            size_t total{0u};
+            for (const Block &block : m_blocks)
+                total += block.size;
+            return total;
+        }
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            bytes = std::max<size_t>(bytes, 1u);
+            for (;;)
+            {
+                for (/*m_block*/; m_block < m_blocks.size(); ++m_block, m_offset = 0u)
+                {
+                    Block &block{m_blocks[m_block]};
+                    uintptr_t base{reinterpret_cast<uintptr_t>(block.data)};
+                    size_t start{((base + m_offset + alignment - 1u) & ~(uintptr_t{alignment} - 1u)) - base};
+                    if (start + bytes <= block.size)
+                    {
+                        m_offset = start + bytes;
+                        m_last = block.data + start;
+                        return m_last;
+                    }
+                }
+                // Out of blocks. Each new one doubles up to s_maxBlockSize, so upstream calls stay few.
+                size_t size{std::max(m_nextBlockSize, bytes + alignment)};
+                m_blocks.push_back(Block{
+                    static_cast<std::byte *>(m_upstream->allocate(size, alignof(std::max_align_t))), size});
+                m_nextBlockSize = std::min(m_nextBlockSize * 2u, std::max(s_maxBlockSize, m_nextBlockSize));
+                m_block = m_blocks.size() - 1u;
+                m_offset = 0u;
+            }
+        }
+
+        void do_deallocate(void *p, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override
+        {
+            if (p && p == m_last)
+            {
+                m_offset = m_last - m_blocks[m_block].data;
+                m_last = nullptr;
+            }
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    }; // VknArena
+
+    // Zero is never a content hash, so it can stand for "unhashed"
+    struct VknHash
+    {
+        uint64_t high{0u};
+        uint64_t low{0u};
+
+        explicit operator bool() const { return high || low; }
+        auto operator<=>(const VknHash &) const = default;
+    };
+
+    // 128-bit FNV-1a. Values go in field by field, so padding and pointers never reach the hash. Equal hashes
+    // are taken as equal content: accidental collisions are negligible at 128 bits, but FNV is no defense
+    // against inputs crafted to collide.
+    class VknHasher
+    {
+        VknHash m_hash{0x6c62272e07bb0142ull, 0x62b821756295c58dull};
+
+    public:
+        void addBytes(const void *data, size_t size)
+        {
+            // The prime is 2^88 + 0x13B, multiplied in 64-bit halves for compilers without a 128-bit type
+            static constexpr uint64_t primeLow{0x13Bull};
+            const unsigned char *bytes{static_cast<const unsigned char *>(data)};
+            for (size_t i = 0; i < size; ++i)
+            {
+                m_hash.low ^= bytes[i];
+                uint64_t carry{((m_hash.low >> 32) * primeLow + (((m_hash.low & 0xFFFFFFFFull) * primeLow) >> 32)) >> 32};
+                m_hash.high = m_hash.high * primeLow + carry + (m_hash.low << 24);
+                m_hash.low *= primeLow;
+            }
+        }
+
+        template <typename... Values>
+        void add(const Values &...values)
+        {
+            static_assert(((std::is_trivially_copyable_v<Values> && !std::is_pointer_v<Values>) && ...),
+                          "Hash what a pointer points to, not the pointer.");
+            (this->addBytes(&values, sizeof(Values)), ...);
+        }
+
+        // Only for element types without padding or pointers
+        template <typename T>
+        void addArray(const T *data, uint_fast32_t count)
+        {
+            this->add(static_cast<uint64_t>(data ? count : 0u));
+            if (data)
+                this->addBytes(data, sizeof(T) * count);
+        }
+
+        void addString(const char *str)
+        {
+            this->addArray(str, str ? std::strlen(str) : 0u);
+        }
+
+        VknHash get() const { return m_hash; }
+    }; // VknHasher
+
     template <typename T>
     T *getListElement(uint_fast32_t idx, std::list<T> &objList)
     {
@@ -36,17 +220,56 @@ namespace vkn
         return &(*it);
     }
 
-    template <typename VecDataType>
+    template <typename VecDataType, typename IdxType>
     class VknVector
     {
+        static_assert(std::is_unsigned_v<IdxType> && sizeof(IdxType) <= 4u,
+                      "VknVector positions must be an unsigned integer type of at most 32 bits.");
+
+        // Wide enough to count every position, so it also holds the "no index" sentinel
+        using SizeType = std::conditional_t<sizeof(IdxType) == 1u, uint_least16_t, uint_least32_t>;
+
+    public:
+        // 32-bit positions give up the top value so the size still fits in SizeType
+        static constexpr SizeType s_maxPos{sizeof(IdxType) < 4u ? std::numeric_limits<IdxType>::max()
+                                                                 : std::numeric_limits<IdxType>::max() - 1u};
+        static constexpr SizeType s_maxDataSize{s_maxPos + 1u};
+
+    private:
+        static constexpr SizeType s_noIdx{s_maxDataSize};
+        // Handles and Vk*CreateInfo structs, which is nearly everything stored here
+        static constexpr bool s_trivial{std::is_trivially_copyable_v<VecDataType>};
+        static constexpr bool s_zeroInit{s_trivial && std::is_trivially_default_constructible_v<VecDataType>};
+
         VecDataType *m_data{nullptr};
-        uint_least8_t *m_positions{nullptr};
-        uint_least16_t m_dataSize{0u};
-        uint_least16_t m_posSize{0u};
+        IdxType *m_positions{nullptr};
+        SizeType *m_lookup{nullptr}; // position -> index, s_noIdx if unassigned
+        uint64_t *m_occupancy{nullptr}; // One bit per lookup entry, set if the position is filed
+        SizeType m_lookupSize{0u};
+        SizeType m_dataSize{0u};
+        SizeType m_posSize{0u};
+        SizeType m_capacity{0u};
+        std::pmr::memory_resource *m_resource{std::pmr::get_default_resource()}; // Backs every array above
+
+        // Same contract as new T[count]/delete[], but the memory comes from m_resource
+        template <typename T>
+        T *allocateArray(uint_fast32_t count)
+        {
+            T *arr = static_cast<T *>(m_resource->allocate(count * sizeof(T), alignof(T)));
+            std::uninitialized_default_construct_n(arr, count);
+            return arr;
+        }
+
+        template <typename T>
+        void deallocateArray(T *arr, uint_fast32_t count)
+        {
+            std::destroy_n(arr, count);
+            m_resource->deallocate(arr, count * sizeof(T), alignof(T));
+        }
 
         uint_fast32_t getNextPosition()
         {
-            if (m_posSize > MAX_DATA_SIZE)
+            if (m_posSize >= s_maxDataSize)
                 throw std::runtime_error("Overflow error. VknVector is full.");
             return m_posSize++;
         }
@@ -56,135 +279,256 @@ namespace vkn
             if (position >= m_posSize)
                 m_posSize = position + 1u;
             m_positions[index] = position;
+            this->mapPosition(index, position);
+        }
+
+        void mapPosition(uint_fast32_t index, uint_fast32_t position)
+        {
+            if (position >= m_lookupSize)
+                this->growLookup(position + 1u);
+            m_lookup[position] = index;
+            m_occupancy[position / 64u] |= uint64_t{1u} << (position % 64u);
+        }
+
+        void unmapPosition(uint_fast32_t position)
+        {
+            if (position >= m_lookupSize)
+                return;
+            m_lookup[position] = s_noIdx;
+            m_occupancy[position / 64u] &= ~(uint64_t{1u} << (position % 64u));
+        }
+
+        static uint_fast32_t numOccupancyWords(uint_fast32_t lookupSize) { return (lookupSize + 63u) / 64u; }
+
+        // Sized to the highest mapped position rather than s_maxDataSize, so wide vectors stay small
+        void growLookup(uint_fast32_t minSize)
+        {
+            uint_fast32_t newSize{std::min<uint_fast32_t>(
+                std::max<uint_fast32_t>(minSize, m_lookupSize * 2u), s_maxDataSize)};
+            SizeType *newLookup = this->allocateArray<SizeType>(newSize);
+            uint64_t *newOccupancy = this->allocateArray<uint64_t>(numOccupancyWords(newSize));
+
+            std::copy(m_lookup, m_lookup + m_lookupSize, newLookup);
+            std::fill(newLookup + m_lookupSize, newLookup + newSize, s_noIdx);
+            std::copy(m_occupancy, m_occupancy + numOccupancyWords(m_lookupSize), newOccupancy);
+            std::fill(newOccupancy + numOccupancyWords(m_lookupSize), newOccupancy + numOccupancyWords(newSize), uint64_t{0u});
+            this->deleteLookup();
+            m_lookup = newLookup;
+            m_occupancy = newOccupancy;
+            m_lookupSize = newSize;
+        }
+
+        SizeType lookupIdx(uint_fast32_t position) const
+        {
+            return position < m_lookupSize ? m_lookup[position] : s_noIdx;
+        }
+
+        void rebuildLookup()
+        {
+            uint_fast32_t i{0u};
+            if (m_lookup)
+            {
+                std::fill(m_lookup, m_lookup + m_lookupSize, s_noIdx);
+                std::fill(m_occupancy, m_occupancy + numOccupancyWords(m_lookupSize), uint64_t{0u});
+            }
+            for (/*i=0*/; i < m_dataSize; ++i)
+                this->mapPosition(i, m_positions[i]);
+        }
+
+        void deleteLookup()
+        {
+            if (m_lookup)
+            {
+                this->deallocateArray(m_lookup, m_lookupSize);
+                this->deallocateArray(m_occupancy, numOccupancyWords(m_lookupSize));
+                m_lookup = nullptr;
+                m_occupancy = nullptr;
+            }
+            m_lookupSize = 0u;
+        }
+
+        void copyLookup(const VknVector &other)
+        {
+            this->deleteLookup();
+            if (!other.m_lookup)
+                return;
+            m_lookup = this->allocateArray<SizeType>(other.m_lookupSize);
+            m_occupancy = this->allocateArray<uint64_t>(numOccupancyWords(other.m_lookupSize));
+            m_lookupSize = other.m_lookupSize;
+            std::copy(other.m_lookup, other.m_lookup + m_lookupSize, m_lookup);
+            std::copy(other.m_occupancy, other.m_occupancy + numOccupancyWords(m_lookupSize), m_occupancy);
+        }
+
+        // Bit scans over the occupancy words, 64 positions per step. std::countr_zero/countl_zero lower
+        // to tzcnt/lzcnt (bsf/bsr without BMI), with a portable fallback chosen by the standard library.
+        // Smallest filed position in [from, to], or s_noIdx
+        uint_fast32_t nextFiledPos(uint_fast32_t from, uint_fast32_t to) const
+        {
+            if (to >= m_lookupSize)
+                to = m_lookupSize - 1u; // Wraps if the lookup is empty, caught below
+            if (m_lookupSize == 0u || from > to)
+                return s_noIdx;
+
+            uint_fast32_t word{from / 64u};
+            uint64_t bits{m_occupancy[word] & (~uint64_t{0u} << (from % 64u))};
+            while (true)
+            {
+                if (bits != 0u)
+                {
+                    uint_fast32_t pos{word * 64u + std::countr_zero(bits)};
+                    return pos <= to ? pos : s_noIdx;
+                }
+                if (++word > to / 64u)
+                    return s_noIdx;
+                bits = m_occupancy[word];
+            }
+        }
+
+        // Largest filed position in [to, from], or s_noIdx
+        uint_fast32_t prevFiledPos(uint_fast32_t from, uint_fast32_t to) const
+        {
+            if (from >= m_lookupSize)
+                from = m_lookupSize - 1u;
+            if (m_lookupSize == 0u || to > from)
+                return s_noIdx;
+
+            uint_fast32_t word{from / 64u};
+            uint64_t bits{m_occupancy[word] & (~uint64_t{0u} >> (63u - from % 64u))};
+            while (true)
+            {
+                if (bits != 0u)
+                {
+                    uint_fast32_t pos{word * 64u + 63u - std::countl_zero(bits)};
+                    return pos >= to ? pos : s_noIdx;
+                }
+                if (word == 0u || --word < to / 64u)
+                    return s_noIdx;
+                bits = m_occupancy[word];
+            }
+        }
+
+        // Smallest unfiled position at or after from. Everything past the lookup is free.
+        uint_fast32_t nextFreePos(uint_fast32_t from) const
+        {
+            uint_fast32_t numWords{numOccupancyWords(m_lookupSize)};
+            uint_fast32_t word{from / 64u};
+            uint64_t mask{~uint64_t{0u} << (from % 64u)};
+            for (/*word = from / 64*/; word < numWords; ++word, mask = ~uint64_t{0u})
+            {
+                uint64_t bits{~m_occupancy[word] & mask};
+                if (bits != 0u)
+                    return word * 64u + std::countr_zero(bits);
+            }
+            return std::max<uint_fast32_t>(from, std::min<uint_fast32_t>(numWords * 64u, s_maxDataSize));
         }
 
         void deleteArrays()
         {
             if (m_data)
             {
-                delete[] m_data;
+                this->deallocateArray(m_data, m_capacity);
                 m_data = nullptr;
             }
             if (m_positions)
             {
-                delete[] m_positions;
+                this->deallocateArray(m_positions, m_capacity);
                 m_positions = nullptr;
             }
+            m_capacity = 0u;
         }
 
-        PosSearchResult getIdxOfSmallestPos(uint_fast32_t minPos, uint_fast32_t maxPos = MAX_POS)
+        // The source is discarded afterwards, so non-trivial types are moved rather than copied
+        static void moveElements(VecDataType *dst, VecDataType *src, uint_fast32_t count)
         {
-            PosSearchResult result{};
-            if (!m_data || minPos >= m_posSize)
-                return result;
+            if constexpr (s_trivial)
+            {
+                if (count != 0u)
+                    std::memmove(dst, src, count * sizeof(VecDataType));
+            }
+            else
+                std::move(src, src + count, dst);
+        }
 
-            uint_fast32_t i{0u};
-            uint_fast32_t smallestPos{MAX_POS};
-            uint_fast32_t smallestPosIdx{0u};
-            result.found = false;
+        static void copyElements(VecDataType *dst, const VecDataType *src, uint_fast32_t count)
+        {
+            if constexpr (s_trivial)
+            {
+                if (count != 0u)
+                    std::memcpy(dst, src, count * sizeof(VecDataType));
+            }
+            else
+                std::copy(src, src + count, dst);
+        }
 
-            for (/*i=0*/; i < this->getSize(); ++i)
-                if (m_positions[i] == minPos)
-                {
-                    result.pos = i;
-                    result.found = true;
-                    return result;
-                }
-                else if (m_positions[i] > minPos && m_positions[i] <= maxPos && m_positions[i] <= smallestPos)
-                {
-                    smallestPos = m_positions[i];
-                    smallestPosIdx = i;
-                    result.found = true;
-                }
-            result.pos = smallestPosIdx;
-            return result;
+        static void movePositions(IdxType *dst, const IdxType *src, uint_fast32_t count)
+        {
+            if (count != 0u)
+                std::memmove(dst, src, count * sizeof(IdxType));
         }
 
-        PosSearchResult getIdxOfLargestPos(uint_fast32_t maxPos, uint_fast32_t minPos = MAX_POS)
+        // Slots past the new size hold moved-from values, reset them so their resources are released now
+        void releaseSlots(uint_fast32_t from)
         {
-            PosSearchResult result;
-            result.found = false;
-            if (!m_data || maxPos >= m_posSize)
-                return result;
+            if constexpr (!s_trivial)
+                std::fill(m_data + from, m_data + m_dataSize, VecDataType{});
+        }
 
-            uint_fast32_t i{m_dataSize};
-            uint_fast32_t largestPos{0u};
-            uint_fast32_t largestPosIdx{0u};
+        void reallocate(uint_fast32_t newCapacity)
+        {
+            VecDataType *newData = this->allocateArray<VecDataType>(newCapacity);
+            IdxType *newPositions = this->allocateArray<IdxType>(newCapacity);
 
-            for (/*i = m_dataSize*/; i > 0u; --i)
-                if (m_positions[i - 1u] == maxPos)
-                {
-                    result.pos = i - 1u;
-                    result.found = true;
-                    return result;
-                }
-                else if (m_positions[i - 1u] < maxPos && m_positions[i - 1u] >= minPos && m_positions[i - 1u] >= largestPos)
-                {
-                    largestPos = m_positions[i - 1u];
-                    largestPosIdx = i - 1u;
-                    result.found = true;
-                }
-            result.pos = largestPosIdx;
+            moveElements(newData, m_data, this->getSize());
+            movePositions(newPositions, m_positions, this->getSize());
+            this->deleteArrays();
+            m_data = newData;
+            m_positions = newPositions;
+            m_capacity = newCapacity;
+        }
+
+        // The searches scan the occupancy bitmap, so the cost is the gap to the next filed position in
+        // 64-position steps rather than the size of the vector. A full iterator sweep stays linear.
+        PosSearchResult getIdxOfSmallestPos(uint_fast32_t minPos, uint_fast32_t maxPos = s_maxPos)
+        {
+            PosSearchResult result{this->getSmallestPos(minPos, maxPos)};
+            if (result.found)
+                result.pos = m_lookup[result.pos];
             return result;
         }
 
-        PosSearchResult getSmallestPos(uint_fast32_t minPos, uint_fast32_t maxPos = MAX_POS)
+        PosSearchResult getIdxOfLargestPos(uint_fast32_t maxPos, uint_fast32_t minPos = s_maxPos)
+        {
+            PosSearchResult result{this->getLargestPos(maxPos, minPos)};
+            if (result.found)
+                result.pos = m_lookup[result.pos];
+            return result;
+        }
+
+        PosSearchResult getSmallestPos(uint_fast32_t minPos, uint_fast32_t maxPos = s_maxPos)
         {
             PosSearchResult result{};
-            result.found = false;
             if (!m_data || minPos >= m_posSize)
                 return result;
 
-            uint_fast32_t smallestPos{MAX_POS};
-            uint_fast32_t position{0};
-            uint_fast32_t i{0u};
-
-            for (/*i=0*/; i < m_dataSize; ++i)
-            {
-                position = m_positions[i];
-                if (position == minPos)
-                {
-                    result.pos = position;
-                    result.found = true;
-                    return result;
-                }
-                else if (position > minPos && position <= maxPos && position <= smallestPos)
-                {
-                    result.found = true;
-                    smallestPos = position;
-                }
-            }
-            result.pos = smallestPos;
+            uint_fast32_t pos{this->nextFiledPos(minPos, maxPos < minPos ? minPos : maxPos)}; // Exact match only if maxPos < minPos
+            if (pos == s_noIdx)
+                return result;
+            result.pos = pos;
+            result.found = true;
             return result;
         }
 
-        PosSearchResult getLargestPos(uint_fast32_t maxPos, uint_fast32_t minPos = MAX_POS)
+        PosSearchResult getLargestPos(uint_fast32_t maxPos, uint_fast32_t minPos = s_maxPos)
         {
             PosSearchResult result{};
-            result.found = false;
             if (!m_data || maxPos >= m_posSize)
                 return result;
 
-            uint_fast32_t i{0u};
-            uint_fast32_t largestPos{0u};
-            uint_fast32_t position{maxPos};
-
-            for (/*i=0*/; i < m_dataSize; ++i)
-            {
-                position = m_positions[i];
-                if (position == maxPos)
-                {
-                    result.found = true;
-                    result.pos = position;
-                    return result;
-                }
-                else if (position < maxPos && position >= minPos && position >= largestPos)
-                {
-                    largestPos = position;
-                    result.found = true;
-                }
-            }
-            result.pos = largestPos;
+            uint_fast32_t pos{this->prevFiledPos(maxPos, minPos > maxPos ? maxPos : minPos)}; // Exact match only if minPos > maxPos
+            if (pos == s_noIdx)
+                return result;
+            result.pos = pos;
+            result.found = true;
             return result;
         }
 
@@ -192,11 +536,11 @@ namespace vkn
         {
             this->grow(m_dataSize + 1u);
             m_data[m_dataSize - 1u] = newElement;
-            m_positions[m_dataSize - 1u] = pos;
+            this->setPosition(m_dataSize - 1u, pos);
             return m_data[m_dataSize - 1u];
         }
 
-        VecDataType *_insert(uint_fast8_t startPos, VecDataType *newElements, uint_fast32_t length)
+        VecDataType *_insert(uint_fast32_t startPos, VecDataType *newElements, uint_fast32_t length)
         {
             uint_fast32_t oldSize = m_dataSize;
             uint_fast32_t i{0};
@@ -204,16 +548,16 @@ namespace vkn
             this->grow(oldSize + length);
             for (/*i=0*/; i < length; ++i)
             {
-                m_data[i] = newElements[i];
-                m_positions[i] = startPos + i;
+                m_data[oldSize + i] = newElements[i];
+                this->setPosition(oldSize + i, startPos + i);
             }
             return &m_data[oldSize];
         }
 
     public:
-        friend class VknVectorIterator<VecDataType>;
+        friend class VknVectorIterator<VecDataType, IdxType>;
 
-        uint_fast8_t getDefragPos(uint_fast32_t length)
+        uint_fast32_t getDefragPos(uint_fast32_t length)
         {
             if (length == 0)
                 throw std::runtime_error("Cannot get defrag position for length 0.");
@@ -223,66 +567,52 @@ namespace vkn
                 return m_posSize;
             else if (this->getSize() == this->getNumPositions())
             {
-                if (MAX_DATA_SIZE - m_posSize >= length)
+                if (s_maxDataSize - m_posSize >= length)
                     return m_posSize;
                 else
                     throw std::runtime_error("Due to fragmentation and/or limited capacity, there is no room in the vector for the specified contiguous data.");
             }
 
-            uint_fast32_t i{0u};
-            PosSearchResult smallestPosRes{};
-
-            for (/*i=0*/; i <= this->getNumPositions(); ++i) //<= because at the last pos + 1 is a good place to add elements
+            // Hop from each free run to the next filed position until a run is long enough
+            uint_fast32_t start{this->nextFreePos(0u)};
+            uint_fast32_t nextFiled{0u};
+            while (start < s_maxDataSize && length <= s_maxDataSize - start)
             {
-                smallestPosRes = this->getSmallestPos(i);
-                if (smallestPosRes.found && (smallestPosRes.pos - i) >= length) // Fixed an off-by-1, does what you think now
-                    return i;
-                else if (!smallestPosRes.found && (MAX_DATA_SIZE - i) >= length) // Yes, correctly determines if enough contiguous space
-                    return i;
-                else if (!smallestPosRes.found)
-                    break;
-                else
-                    i = smallestPosRes.pos;
+                nextFiled = this->nextFiledPos(start, s_maxPos);
+                if (nextFiled == s_noIdx || nextFiled - start >= length)
+                    return start;
+                start = this->nextFreePos(nextFiled);
             }
             throw std::runtime_error("Due to fragmentation and/or limited capacity, there is no room in the vector for the specified contiguous data.");
         }
 
-        void remove(uint_fast8_t position)
+        void remove(uint_fast32_t position)
         {
             if (this->isEmpty())
                 throw std::runtime_error("Cannot remove from an empty vector.");
             if (!this->getElement(position))
                 return;
-            if (this->getSize() == 1u)
-            {
-                this->clear();
-                return;
-            }
 
-            VecDataType *newData = new VecDataType[this->getSize() - 1u];
-            uint_least8_t *newPositions = new uint_least8_t[this->getSize() - 1u];
-            uint_fast32_t newIdx{0u};
-            uint_fast32_t oldIdx{0u};
+            // Shift the tail down in place, storage is kept for the next insert
+            uint_fast32_t removeIdx{this->lookupIdx(position)};
+            uint_fast32_t tailSize{this->getSize() - removeIdx - 1u};
+            uint_fast32_t i{removeIdx};
 
-            while (oldIdx < this->getSize())
-            {
-                if (m_positions[oldIdx] != position)
-                {
-                    newData[newIdx] = m_data[oldIdx];
-                    newPositions[newIdx] = m_positions[oldIdx];
-                    ++newIdx;
-                }
-                ++oldIdx;
-            }
-            this->deleteArrays();
-            m_data = newData;
-            m_positions = newPositions;
+            moveElements(m_data + removeIdx, m_data + removeIdx + 1u, tailSize);
+            movePositions(m_positions + removeIdx, m_positions + removeIdx + 1u, tailSize);
+            this->releaseSlots(m_dataSize - 1u);
             --m_dataSize;
-            if (position == m_posSize - 1u)
+            this->unmapPosition(position);
+            for (/*i = removeIdx*/; i < m_dataSize; ++i)
+                m_lookup[m_positions[i]] = i;
+
+            if (m_dataSize == 0u)
+                m_posSize = 0u;
+            else if (position == m_posSize - 1u)
                 --m_posSize;
         }
 
-        void remove(uint_fast8_t startPos, uint_fast32_t length)
+        void remove(uint_fast32_t startPos, uint_fast32_t length)
         {
             if (this->isEmpty())
                 throw std::runtime_error("Cannot remove from an empty vector.");
@@ -296,63 +626,99 @@ namespace vkn
                 {
                     if (writeIdx != readIdx)
                     {
-                        m_data[writeIdx] = m_data[readIdx];
+                        m_data[writeIdx] = std::move(m_data[readIdx]);
                         m_positions[writeIdx] = m_positions[readIdx];
-                        highestPos = m_positions[writeIdx] > highestPos ? m_positions[writeIdx] : highestPos;
                     }
+                    highestPos = m_positions[writeIdx] > highestPos ? m_positions[writeIdx] : highestPos;
                     ++writeIdx;
                 }
                 ++readIdx;
             }
-            if (writeIdx == 0u)
-            {
-                this->clear();
-                return;
-            }
-            else if (writeIdx < this->getSize())
+            if (writeIdx < this->getSize())
             {
-                VecDataType *newData = new VecDataType[writeIdx];
-                uint_least8_t *newPositions = new uint_least8_t[writeIdx];
-                for (readIdx = 0u; readIdx < writeIdx; ++readIdx) // might as well reuse readIdx
-                {
-                    newData[readIdx] = m_data[readIdx];
-                    newPositions[readIdx] = m_positions[readIdx];
-                }
-                this->deleteArrays();
-                m_data = newData;
-                m_positions = newPositions;
+                this->releaseSlots(writeIdx);
                 m_dataSize = writeIdx;
-                m_posSize = highestPos + 1u;
+                m_posSize = writeIdx == 0u ? 0u : highestPos + 1u;
+                this->rebuildLookup();
             }
         }
 
-        void grow(uint_fast32_t newSize)
+        // Renumbers positions densely in their current order and sorts storage to match, so any
+        // position range becomes physically contiguous. Returns a table of old position -> new position.
+        VknVector<uint_least32_t, IdxType> compact()
         {
-            if (newSize < this->getSize() || newSize > MAX_DATA_SIZE)
-                throw std::runtime_error("Invalid size for VknVector.");
-            uint_fast32_t i{0u};
-            VecDataType *newData = new VecDataType[newSize];
-            uint_least8_t *newPositions = new uint_least8_t[newSize];
+            VknVector<uint_least32_t, IdxType> remap{m_resource};
+            if (this->isEmpty())
+                return remap;
 
-            for (/*i=0*/; i < this->getSize(); ++i)
-            {
-                newData[i] = m_data[i];
-                newPositions[i] = m_positions[i];
-            }
-            for (i = this->getSize(); i < newSize; ++i)
+            VecDataType *newData = this->allocateArray<VecDataType>(m_capacity);
+            IdxType *newPositions = this->allocateArray<IdxType>(m_capacity);
+            uint_fast32_t pos{0u};
+            uint_fast32_t newIdx{0u};
+            SizeType oldIdx{0u};
+
+            remap.reserve(this->getSize());
+            for (/*pos = 0*/; pos < m_posSize; ++pos)
             {
-                newData[i] = VecDataType{};
-                newPositions[i] = 0;
+                oldIdx = this->lookupIdx(pos);
+                if (oldIdx == s_noIdx)
+                    continue;
+                newData[newIdx] = std::move(m_data[oldIdx]);
+                newPositions[newIdx] = newIdx;
+                remap.insert(pos, newIdx);
+                ++newIdx;
             }
+
+            uint_fast32_t capacity{m_capacity};
             this->deleteArrays();
             m_data = newData;
             m_positions = newPositions;
+            m_capacity = capacity;
+            m_dataSize = newIdx; // Unpositioned filler slots from grow() are dropped
+            m_posSize = newIdx;
+            this->rebuildLookup();
+            return remap;
+        }
+
+        void grow(uint_fast32_t newSize)
+        {
+            if (newSize < this->getSize() || newSize > s_maxDataSize)
+                throw std::runtime_error("Invalid size for VknVector.");
+            uint_fast32_t oldSize{this->getSize()};
+
+            if (newSize > m_capacity) // Geometric growth, so appending N elements reallocates O(log N) times
+                this->reallocate(std::max<uint_fast32_t>(
+                    newSize, std::min<uint_fast32_t>(m_capacity * 2u, s_maxDataSize)));
+            if (newSize == oldSize)
+                return;
+            if constexpr (s_zeroInit) // Same result as VecDataType{} without constructing each slot
+                std::memset(m_data + oldSize, 0, (newSize - oldSize) * sizeof(VecDataType));
+            else
+                std::fill(m_data + oldSize, m_data + newSize, VecDataType{});
+            std::fill(m_positions + oldSize, m_positions + newSize, IdxType{0u});
             m_dataSize = newSize;
         }
 
+        void reserve(uint_fast32_t newCapacity)
+        {
+            if (newCapacity > s_maxDataSize)
+                throw std::runtime_error("Invalid capacity for VknVector.");
+            if (newCapacity > m_capacity)
+                this->reallocate(newCapacity);
+        }
+
+        void shrink_to_fit()
+        {
+            if (this->getSize() == 0u)
+                this->clear();
+            else if (m_capacity > this->getSize())
+                this->reallocate(this->getSize());
+        }
+
         void clear()
         {
             this->deleteArrays();
+            this->deleteLookup();
             m_dataSize = 0u;
             m_posSize = 0u;
         }
@@ -361,9 +727,16 @@ namespace vkn
         {
         }
 
+        // Every allocation, including growth and the position lookup, comes from resource. Copies use the
+        // default resource (or keep the target's), moves carry the resource along with the storage.
+        explicit VknVector(std::pmr::memory_resource *resource) : m_resource{resource}
+        {
+        }
+
         ~VknVector()
         {
             this->deleteArrays();
+            this->deleteLookup();
         }
 
         VknVector(const VknVector &other)
@@ -377,20 +750,20 @@ namespace vkn
             }
             else
             {
-                uint_fast32_t i{0u};
-                m_positions = new uint_least8_t[m_dataSize];
-                m_data = new VecDataType[m_dataSize];
+                m_positions = this->allocateArray<IdxType>(m_dataSize);
+                m_data = this->allocateArray<VecDataType>(m_dataSize);
+                m_capacity = m_dataSize;
 
-                for (/*i = 0u*/; i < this->getSize(); ++i)
-                {
-                    this->setPosition(i, other.m_positions[i]);
-                    m_data[i] = other.m_data[i];
-                }
+                movePositions(m_positions, other.m_positions, m_dataSize);
+                copyElements(m_data, other.m_data, m_dataSize);
             }
+            this->copyLookup(other);
         }
 
         VknVector &operator=(const VknVector &other)
         {
+            if (this == &other)
+                return *this;
             uint_fast32_t otherSize{other.getSize()};
             this->deleteArrays();
             m_dataSize = other.m_dataSize;
@@ -403,16 +776,14 @@ namespace vkn
             }
             else
             {
-                uint_fast32_t i{0u};
-                m_positions = new uint_least8_t[otherSize];
-                m_data = new VecDataType[otherSize];
+                m_positions = this->allocateArray<IdxType>(otherSize);
+                m_data = this->allocateArray<VecDataType>(otherSize);
+                m_capacity = otherSize;
 
-                for (/*i = 0u*/; i < otherSize; ++i)
-                {
-                    m_positions[i] = other.m_positions[i];
-                    m_data[i] = other.m_data[i];
-                }
+                movePositions(m_positions, other.m_positions, otherSize);
+                copyElements(m_data, other.m_data, otherSize);
             }
+            this->copyLookup(other);
             return *this; // Return a reference to the current object
         }
 
@@ -422,14 +793,23 @@ namespace vkn
             // Steal resources
             m_positions = other.m_positions;
             m_data = other.m_data;
+            m_lookup = other.m_lookup;
+            m_occupancy = other.m_occupancy;
+            m_lookupSize = other.m_lookupSize;
             m_dataSize = other.m_dataSize;
             m_posSize = other.m_posSize;
+            m_capacity = other.m_capacity;
+            m_resource = other.m_resource;
 
             // Null out other's pointers so its destructor does nothing
             other.m_positions = nullptr;
             other.m_data = nullptr;
+            other.m_lookup = nullptr;
+            other.m_occupancy = nullptr;
+            other.m_lookupSize = 0u;
             other.m_dataSize = 0u; // Or appropriate default
             other.m_posSize = 0u;  // Or appropriate default
+            other.m_capacity = 0u;
 
             // DO NOT call other.deleteArrays(); here!
         }
@@ -441,18 +821,28 @@ namespace vkn
             {
                 // Release existing resources
                 this->deleteArrays();
+                this->deleteLookup();
 
                 // Steal resources from other
                 m_positions = other.m_positions;
                 m_data = other.m_data;
+                m_lookup = other.m_lookup;
+                m_occupancy = other.m_occupancy;
+                m_lookupSize = other.m_lookupSize;
                 m_dataSize = other.m_dataSize;
                 m_posSize = other.m_posSize;
+                m_capacity = other.m_capacity;
+                m_resource = other.m_resource;
 
                 // Null out other's pointers
                 other.m_positions = nullptr;
                 other.m_data = nullptr;
+                other.m_lookup = nullptr;
+                other.m_occupancy = nullptr;
+                other.m_lookupSize = 0u;
                 other.m_dataSize = 0u;
                 other.m_posSize = 0u;
+                other.m_capacity = 0u;
 
                 // DO NOT call other.deleteArrays(); here!
             }
@@ -467,24 +857,41 @@ namespace vkn
             return *result;
         }
 
-        VknVectorIterator<VecDataType> getSlice(uint_fast32_t startPos, uint_fast32_t length)
+        VknVectorIterator<VecDataType, IdxType> getSlice(uint_fast32_t startPos, uint_fast32_t length)
         {
-            if (startPos + length > MAX_DATA_SIZE) // Also catches if startPos is too large
+            if (startPos + length > s_maxDataSize) // Also catches if startPos is too large
                 throw std::runtime_error("Slice range exceeds maximum data size.");
 
-            return VknVectorIterator<VecDataType>{
+            return VknVectorIterator<VecDataType, IdxType>{
                 this, startPos, length};
         }
 
+        // Returns the elements at [startPos, startPos + length) as one contiguous block, or an empty span
+        // if those positions are not all filed in consecutive slots.
+        std::span<VecDataType> getSpan(uint_fast32_t startPos, uint_fast32_t length)
+        {
+            if (length == 0u || startPos + length > m_posSize)
+                return {};
+            SizeType firstIdx{this->lookupIdx(startPos)};
+            if (firstIdx == s_noIdx || firstIdx + length > m_dataSize)
+                return {};
+
+            uint_fast32_t i{1u};
+            for (/*i=1*/; i < length; ++i)
+                if (this->lookupIdx(startPos + i) != firstIdx + i)
+                    return {};
+            return std::span<VecDataType>{m_data + firstIdx, length};
+        }
+
         VecDataType &appendOne(VecDataType newElement)
         {
             this->grow(this->getSize() + 1u);
-            m_positions[m_dataSize - 1u] = this->getNextPosition();
+            this->setPosition(m_dataSize - 1u, this->getNextPosition());
             m_data[m_dataSize - 1u] = newElement;
             return m_data[m_dataSize - 1u];
         }
 
-        VknVectorIterator<VecDataType> appendVector(VknVector<VecDataType> &newElements)
+        VknVectorIterator<VecDataType, IdxType> appendVector(VknVector &newElements)
         {
             uint_fast32_t i{0u};
             uint_fast32_t oldSize{this->getSize()};
@@ -493,9 +900,9 @@ namespace vkn
             for (/*i = 0u*/; i < newElements.m_dataSize; ++i)
             {
                 m_data[oldSize + i] = newElements(i);
-                m_positions[oldSize + i] = this->getNextPosition();
+                this->setPosition(oldSize + i, this->getNextPosition());
             }
-            return VknVectorIterator(this, oldSize, m_dataSize - oldSize);
+            return VknVectorIterator<VecDataType, IdxType>(this, oldSize, m_dataSize - oldSize);
         }
 
         VecDataType *appendArray(VecDataType *arr, uint_fast32_t length)
@@ -507,7 +914,7 @@ namespace vkn
             for (/*i = 0u*/; i < length; ++i)
             {
                 m_data[oldSize + i] = arr[i];
-                m_positions[oldSize + i] = this->getNextPosition();
+                this->setPosition(oldSize + i, this->getNextPosition());
             }
             return &m_data[oldSize];
         }
@@ -521,7 +928,7 @@ namespace vkn
             for (/*i = oldSize*/; i < this->getSize(); ++i)
             {
                 m_data[i] = value;
-                m_positions[i] = this->getNextPosition();
+                this->setPosition(i, this->getNextPosition());
             }
             return &m_data[oldSize];
         }
@@ -530,15 +937,10 @@ namespace vkn
         {
             if (this->getSize() == 0u)
                 return nullptr;
-            else if (position > MAX_POS)
+            else if (position > s_maxPos)
                 throw std::runtime_error("Position out of range.");
-            uint_fast32_t i{0u};
-            for (/*i = 0u*/; i < this->getSize(); ++i)
-            {
-                if (m_positions[i] == position)
-                    return &m_data[i];
-            }
-            return nullptr;
+            SizeType idx{this->lookupIdx(position)};
+            return idx == s_noIdx ? nullptr : &m_data[idx];
         }
 
         uint_fast32_t defragInsert(VecDataType element)
@@ -555,18 +957,21 @@ namespace vkn
             return pos;
         }
 
+        // Position of the element at storage index, for walking storage densely past removed positions
+        uint_fast32_t getPosition(uint_fast32_t index) const
+        {
+            if (index >= m_dataSize)
+                throw std::runtime_error("Index out of range.");
+            return m_positions[index];
+        }
+
         bool exists(uint_fast32_t position)
         {
             if (!m_data)
                 return false;
-            else if (position > MAX_POS)
+            else if (position > s_maxPos)
                 throw std::runtime_error("Position out of range!");
-            uint_fast32_t i{0u};
-
-            for (/*i=0*/; i < this->getSize(); ++i)
-                if (m_positions[i] == position)
-                    return true;
-            return false;
+            return this->lookupIdx(position) != s_noIdx;
         }
 
         VecDataType &insert(uint_fast32_t position, VecDataType newElement)
@@ -594,32 +999,38 @@ namespace vkn
 
         void swap(uint_fast32_t position1, uint_fast32_t position2)
         {
-            if (position1 > MAX_POS || position2 > MAX_POS)
+            if (position1 > s_maxPos || position2 > s_maxPos)
                 throw std::runtime_error("Position out of range!");
 
-            std::optional<uint_fast8_t> idx1{};
-            std::optional<uint_fast8_t> idx2{};
-            uint_fast32_t i{0u};
+            if (!m_lookup || position1 == position2)
+                return;
 
-            for (/*i = 0u*/; i < this->getSize(); ++i)
-            {
-                if (m_positions[i] == position1)
-                    idx1 = i;
-                else if (m_positions[i] == position2)
-                    idx2 = i;
-            }
+            SizeType idx1{this->lookupIdx(position1)};
+            SizeType idx2{this->lookupIdx(position2)};
 
-            if (idx1.has_value())
-                m_positions[idx1.value()] = position2;
-            if (idx2.has_value())
-                m_positions[idx2.value()] = position1;
+            if (idx1 == s_noIdx && idx2 == s_noIdx)
+                return;
+            if (std::max(position1, position2) >= m_lookupSize)
+                this->growLookup(std::max(position1, position2) + 1u);
+            if (idx1 != s_noIdx)
+                m_positions[idx1] = position2;
+            if (idx2 != s_noIdx)
+                m_positions[idx2] = position1;
+            if (idx2 != s_noIdx)
+                this->mapPosition(idx2, position1);
+            else
+                this->unmapPosition(position1);
+            if (idx1 != s_noIdx)
+                this->mapPosition(idx1, position2);
+            else
+                this->unmapPosition(position2);
         }
 
         VecDataType *getData(uint_fast32_t numNewElements = 0u)
         {
             if (numNewElements != 0u)
             {
-                if (m_dataSize + numNewElements > MAX_DATA_SIZE)
+                if (m_dataSize + numNewElements > s_maxDataSize)
                     throw std::runtime_error("Resizing of internal array causes an overflow error.");
 
                 uint_fast32_t oldSize{this->getSize()};
@@ -630,13 +1041,13 @@ namespace vkn
                 for (/*i = oldSize*/; i < m_dataSize; ++i)
                 {
                     if (startPos + i >= m_posSize)
-                        m_positions[i] = this->getNextPosition();
+                        this->setPosition(i, this->getNextPosition());
                     else
-                        m_positions[i] = startPos + i;
+                        this->setPosition(i, startPos + i);
                 }
                 return m_data + oldSize;
             }
-            return m_data;
+            return this->isEmpty() ? nullptr : m_data;
         }
 
         VecDataType *begin() { return m_data; }
@@ -648,13 +1059,23 @@ namespace vkn
         const VecDataType *rbegin() const { return m_data + this->getSize() - 1u; }
         const VecDataType *rend() const { return m_data - 1u; }
 
-        bool isEmpty() const { return !m_data; }
+        bool isEmpty() const { return !m_data || m_dataSize == 0u; }
         const uint_fast32_t getSize() const { return m_dataSize; }
         uint_fast32_t size() const { return this->getSize(); }
+        uint_fast32_t getCapacity() const { return m_capacity; }
+        std::pmr::memory_resource *getMemoryResource() const { return m_resource; }
+
+        // Only valid before anything is allocated, storage can't move between resources in place
+        void setMemoryResource(std::pmr::memory_resource *resource)
+        {
+            if (m_data || m_lookup)
+                throw std::runtime_error("Cannot change the memory resource of a VknVector that holds storage.");
+            m_resource = resource;
+        }
         uint_fast32_t getNumPositions() const { return m_posSize; }
     };
 
-    template <typename IterDataType>
+    template <typename IterDataType, typename IdxType>
     class VknVectorIterator
     {
     public:
@@ -665,11 +1086,13 @@ namespace vkn
         using reference = IterDataType &;
 
     private:
-        VknVector<IterDataType> *m_vec;
-        uint_fast8_t m_firstPos{0u};
-        uint_fast8_t m_lastPos{0u};
-        uint_fast8_t m_currentIdx{0u};
-        uint_fast8_t m_currentPos{0u};
+        static constexpr uint_fast32_t s_maxPos{VknVector<IterDataType, IdxType>::s_maxPos};
+
+        VknVector<IterDataType, IdxType> *m_vec;
+        uint_fast32_t m_firstPos{0u};
+        uint_fast32_t m_lastPos{0u};
+        uint_fast32_t m_currentIdx{0u};
+        uint_fast32_t m_currentPos{0u};
 
         bool m_isInvalid{false};
         bool m_atEnd{false};
@@ -679,7 +1102,7 @@ namespace vkn
 
     public:
         // TODO: Find out what explicit keyword does
-        explicit VknVectorIterator(VknVector<IterDataType> *vknVector,
+        explicit VknVectorIterator(VknVector<IterDataType, IdxType> *vknVector,
                                    uint_least32_t firstPos = 0u, uint_least32_t length = 0u, // Todo
                                    bool iteratefiledElementsOnly = true)
             : m_vec(vknVector),
@@ -768,7 +1191,7 @@ namespace vkn
             }
 
             PosSearchResult nextIdxResult{};
-            if (m_currentIdx == MAX_POS)
+            if (m_currentIdx + 1u >= m_vec->getSize())
                 nextIdxResult = m_vec->getIdxOfSmallestPos(m_currentPos + 1u, m_lastPos);
             else if (m_vec->m_positions[m_currentIdx + 1u] == m_currentPos + 1u)
             {
@@ -825,7 +1248,7 @@ namespace vkn
             }
 
             PosSearchResult nextIdxResult{};
-            if (m_currentIdx == MAX_POS)
+            if (m_currentIdx == 0u)
                 nextIdxResult = m_vec->getIdxOfLargestPos(m_currentPos - 1u, m_firstPos);
             else if (m_vec->m_positions[m_currentIdx - 1u] == m_currentPos - 1u)
             {
@@ -936,12 +1359,12 @@ namespace vkn
 
         VknVectorIterator operator+(difference_type diff)
         {
-            VknVectorIterator<IterDataType> temp{*this};
+            VknVectorIterator temp{*this};
             if (m_atEnd)
                 throw std::runtime_error("Accessing out-of-range vector element.");
-            if (m_currentPos > MAX_POS - diff) // same as m_currentPos + diff > maxSizeTypeNum
+            if (static_cast<difference_type>(m_currentPos) > static_cast<difference_type>(s_maxPos) - diff) // same as m_currentPos + diff > maxSizeTypeNum
             {
-                temp.m_currentPos = MAX_POS;
+                temp.m_currentPos = s_maxPos;
                 temp.m_atEnd = true;
             }
             else
@@ -972,10 +1395,10 @@ namespace vkn
 
         VknVectorIterator operator-(difference_type diff)
         {
-            VknVectorIterator<IterDataType> temp{*this};
+            VknVectorIterator temp{*this};
             if (m_atBegin)
                 throw std::runtime_error("Accessing out-of-range vector element.");
-            if (m_currentPos < diff) // same as m_currentPos - diff < 0
+            if (static_cast<difference_type>(m_currentPos) < diff) // same as m_currentPos - diff < 0
             {
                 temp.m_currentPos = 0u;
                 temp.m_atBegin = true;
@@ -1015,10 +1438,10 @@ namespace vkn
                 return 0u;
             else // Size is number of filed positions, which may be out of order
             {
-                uint_fast32_t idx{0};
+                uint_fast32_t pos{m_firstPos};
                 uint_fast32_t size{0u};
-                for (/*idx = 0*/; idx < m_vec->getSize(); ++idx)
-                    if (m_vec->m_positions[idx] >= m_firstPos && m_vec->m_positions[idx] <= m_lastPos)
+                for (/*pos = m_firstPos*/; pos <= m_lastPos && pos < m_vec->m_posSize; ++pos)
+                    if (m_vec->lookupIdx(pos) != VknVector<IterDataType, IdxType>::s_noIdx)
                         ++size;
                 return size;
             }
@@ -1026,23 +1449,21 @@ namespace vkn
 
         bool isEmpty() { return m_isEmpty; }
 
-        IterDataType *getData()
+        // The whole range as one block of memory, without copying. Throws if the range has gaps or is
+        // stored out of order.
+        std::span<IterDataType> getSpan()
         {
             if (m_isEmpty)
-                return nullptr;
-            PosSearchResult posSearch{m_vec->getIdxOfSmallestPos(m_firstPos)};
-            uint_least32_t idx{};
-            if (posSearch.found)
-                idx = posSearch.pos;
-            else
-                return nullptr;
+                return {};
+            std::span<IterDataType> span{m_vec->getSpan(m_firstPos, (m_lastPos - m_firstPos) + 1u)};
+            if (span.empty())
+                throw std::runtime_error("Iterator range is not contiguous.");
+            return span;
+        }
 
-            if (m_vec->m_positions[idx] != m_firstPos)
-                throw std::runtime_error("Cannot getData(). Iterator range is not obviously contiguous.");
-            for (uint_least32_t i = idx; m_vec->m_positions[i] < m_lastPos; ++i)
-                if (m_vec->m_positions[i + 1u] != m_vec->m_positions[i] + 1u)
-                    throw std::runtime_error("Cannot getData(). Iterator range is not obviously contiguous.");
-            return &m_vec->m_data[idx];
+        IterDataType *getData()
+        {
+            return this->getSpan().data();
         }
 
         uint_least32_t getLogicalPosition()
@@ -1056,20 +1477,22 @@ namespace vkn
         bool isInvalid() { return m_isInvalid; }
     };
 
-    template <typename SpaceDataType>
+    template <typename SpaceDataType, typename IdxType = uint_least8_t>
     class VknSpace
     {
         static constexpr uint_least32_t s_maxDimensions{8};
-        VknVector<SpaceDataType> m_data{};
-        VknVector<VknSpace<SpaceDataType>> m_subspaces{};
+        VknVector<SpaceDataType, IdxType> m_data{}; // Only the data width varies, subspaces are bounded by s_maxDimensions
+        VknVector<VknSpace> m_subspaces{};
         uint_least8_t m_depth{0u};
         uint_least8_t m_maxDepth{0u};
         bool m_dataOnLeafsOnly{true};
 
     public:
         // VknSpace() = default;
-        VknSpace(uint_fast32_t maxDepth = MAX_POS, uint_fast32_t depth = 0u, bool dataOnLeafsOnly = true)
-            : m_depth(depth), m_maxDepth(maxDepth), m_dataOnLeafsOnly{dataOnLeafsOnly} {}
+        VknSpace(uint_fast32_t maxDepth = MAX_POS, uint_fast32_t depth = 0u, bool dataOnLeafsOnly = true,
+                 std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : m_data(resource), m_subspaces(resource),
+              m_depth(depth), m_maxDepth(maxDepth), m_dataOnLeafsOnly{dataOnLeafsOnly} {}
         ~VknSpace() = default;
 
         // Copy Constructor
@@ -1124,7 +1547,7 @@ namespace vkn
             return *this;
         }
 
-        VknSpace<SpaceDataType> &getSubspace(uint8_t position)
+        VknSpace &getSubspace(uint8_t position)
         {
             if (position >= s_maxDimensions)
                 throw std::runtime_error("Position given is out of range.");
@@ -1137,20 +1560,52 @@ namespace vkn
         {
             if (m_depth + 1u > m_maxDepth)
                 throw std::runtime_error("Trying to dive too deep into VknSpace. New depth > max depth.");
-            m_subspaces.insert(position, VknSpace<SpaceDataType>{m_maxDepth, m_depth + 1u, m_dataOnLeafsOnly});
+            VknSpace &subspace{m_subspaces.insert(position, VknSpace{m_maxDepth, m_depth + 1u, m_dataOnLeafsOnly})};
+            subspace.m_data.setMemoryResource(m_subspaces.getMemoryResource()); // Still empty, the whole tree shares one resource
+            subspace.m_subspaces.setMemoryResource(m_subspaces.getMemoryResource());
         }
 
-        VknVectorIterator<VknSpace<SpaceDataType>> getSubspaceSlice(
+        VknVectorIterator<VknSpace> getSubspaceSlice(
             uint8_t startPos, uint8_t length)
         {
             return m_subspaces.getSlice(startPos, length);
         }
 
-        VknSpace<SpaceDataType> &operator[](uint_fast32_t position)
+        VknSpace &operator[](uint_fast32_t position)
         {
             return this->getSubspace(position);
         }
 
+        // Read-only lookups. Unlike getSubspace()/operator[] these never dive, a missing subspace or
+        // element comes back as nullptr and the space is left untouched.
+        VknSpace *find(uint_fast32_t position)
+        {
+            if (position >= s_maxDimensions)
+                return nullptr;
+            return m_subspaces.getElement(position);
+        }
+
+        template <typename... Positions>
+        VknSpace *find(uint_fast32_t position, Positions... positions)
+        {
+            VknSpace *subspace{this->find(position)};
+            return subspace ? subspace->find(positions...) : nullptr;
+        }
+
+        // The last position indexes the data, any before it select subspaces: tryGet(d, r, s) is [d][r](s)
+        SpaceDataType *tryGet(uint_fast32_t position)
+        {
+            this->dataLeafTest();
+            return m_data.getElement(position);
+        }
+
+        template <typename... Positions>
+        SpaceDataType *tryGet(uint_fast32_t position, Positions... positions)
+        {
+            VknSpace *subspace{this->find(position)};
+            return subspace ? subspace->tryGet(positions...) : nullptr;
+        }
+
         void dataLeafTest()
         {
             if (m_dataOnLeafsOnly && m_depth != m_maxDepth)
@@ -1175,12 +1630,12 @@ namespace vkn
             this->dataLeafTest();
             return m_data.getData(newSize);
         }
-        VknVector<SpaceDataType> &getDataVector()
+        VknVector<SpaceDataType, IdxType> &getDataVector()
         {
             this->dataLeafTest();
             return m_data;
         }
-        VknVector<VknSpace<SpaceDataType>> &getSubspaceVector() { return m_subspaces; }
+        VknVector<VknSpace> &getSubspaceVector() { return m_subspaces; }
         SpaceDataType &append(SpaceDataType element)
         {
             this->dataLeafTest();
@@ -1198,6 +1653,168 @@ namespace vkn
         }
         uint_fast32_t getDepth() { return m_depth; }
         uint_fast32_t getMaxDepth() { return m_maxDepth; }
+        std::pmr::memory_resource *getMemoryResource() { return m_subspaces.getMemoryResource(); }
+    };
+
+    // Same []/() surface as a VknSpace with data on its leafs only, but the leafs are kept in one pool
+    // keyed by their packed coordinate, e.g. (device, renderpass). Reaching a leaf is one hashed probe
+    // instead of a walk through every level. Leaf vectors may move when a leaf is added, the elements
+    // they hold do not.
+    template <typename SpaceDataType, typename IdxType = uint_least8_t>
+    class VknFlatSpace
+    {
+        using Leaf = VknVector<SpaceDataType, IdxType>;
+        static constexpr uint_least32_t s_maxDepth{8u}; // 8 bits of coordinate per level in a 64-bit key
+        static constexpr uint_least32_t s_noLeaf{std::numeric_limits<uint_least32_t>::max()};
+
+        std::pmr::vector<Leaf> m_leaves;
+        std::pmr::vector<uint64_t> m_keys;        // Open-addressed, linear probing
+        std::pmr::vector<uint_least32_t> m_slots; // Index into m_leaves, s_noLeaf if unused
+        uint_least8_t m_maxDepth{0u};
+
+        uint_fast32_t probe(uint64_t key) const
+        {
+            uint_fast32_t mask{static_cast<uint_fast32_t>(m_slots.size() - 1u)};
+            uint_fast32_t slot{static_cast<uint_fast32_t>((key * 0x9E3779B97F4A7C15ull) >> 32u) & mask};
+            while (m_slots[slot] != s_noLeaf && m_keys[slot] != key)
+                slot = (slot + 1u) & mask;
+            return slot;
+        }
+
+        void rehash(uint_fast32_t newSize)
+        {
+            std::pmr::vector<uint64_t> oldKeys{std::move(m_keys)};
+            std::pmr::vector<uint_least32_t> oldSlots{std::move(m_slots)};
+            uint_fast32_t i{0u};
+
+            m_keys.assign(newSize, 0u);
+            m_slots.assign(newSize, s_noLeaf);
+            for (/*i=0*/; i < oldSlots.size(); ++i)
+                if (oldSlots[i] != s_noLeaf)
+                {
+                    uint_fast32_t slot{this->probe(oldKeys[i])};
+                    m_keys[slot] = oldKeys[i];
+                    m_slots[slot] = oldSlots[i];
+                }
+        }
+
+        Leaf &getLeaf(uint64_t key)
+        {
+            if ((m_leaves.size() + 1u) * 2u > m_slots.size()) // Keep the load factor at or under 1/2
+                this->rehash(std::max<uint_fast32_t>(16u, m_slots.size() * 2u));
+            uint_fast32_t slot{this->probe(key)};
+            if (m_slots[slot] == s_noLeaf)
+            {
+                m_keys[slot] = key;
+                m_slots[slot] = m_leaves.size();
+                m_leaves.emplace_back(this->getMemoryResource());
+            }
+            return m_leaves[m_slots[slot]];
+        }
+
+        Leaf *findLeaf(const uint_fast32_t *positions, uint_fast32_t depth)
+        {
+            if (depth != m_maxDepth)
+                throw std::runtime_error("Data On Leafs Only is set. Cannot access data members at any depth lower than maxDepth.");
+            uint64_t key{0u};
+            uint_fast32_t i{0u};
+            for (/*i=0*/; i < depth; ++i)
+                if (positions[i] > std::numeric_limits<uint8_t>::max())
+                    return nullptr;
+                else
+                    key |= static_cast<uint64_t>(positions[i]) << (8u * i);
+
+            if (m_slots.empty())
+                return nullptr;
+            uint_fast32_t slot{this->probe(key)};
+            return m_slots[slot] == s_noLeaf ? nullptr : &m_leaves[m_slots[slot]];
+        }
+
+    public:
+        class Node
+        {
+            friend class VknFlatSpace;
+            VknFlatSpace *m_space;
+            uint64_t m_key;
+            uint_least8_t m_depth;
+
+            Node(VknFlatSpace *space, uint64_t key, uint_least8_t depth)
+                : m_space{space}, m_key{key}, m_depth{depth} {}
+
+            Leaf &leaf()
+            {
+                if (m_depth != m_space->m_maxDepth)
+                    throw std::runtime_error("Data On Leafs Only is set. Cannot access data members at any depth lower than maxDepth.");
+                return m_space->getLeaf(m_key);
+            }
+
+        public:
+            Node operator[](uint_fast32_t position)
+            {
+                return m_space->descend(m_key, m_depth, position);
+            }
+
+            SpaceDataType &operator()(uint_fast32_t position)
+            {
+                Leaf &data{this->leaf()};
+                if (data.isEmpty())
+                    throw std::runtime_error("No data is set at this depth.");
+                return data(position);
+            }
+            SpaceDataType *getData(uint_fast32_t newSize = 0u) { return this->leaf().getData(newSize); }
+            Leaf &getDataVector() { return this->leaf(); }
+            SpaceDataType &append(SpaceDataType element) { return this->leaf().appendOne(element); }
+            SpaceDataType &insert(SpaceDataType element, uint_fast32_t position) { return this->leaf().insert(position, element); }
+            uint_fast32_t getDataSize() { return this->leaf().getSize(); }
+            uint_fast32_t getDepth() { return m_depth; }
+        };
+
+        VknFlatSpace(uint_fast32_t maxDepth, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : m_leaves(resource), m_keys(resource), m_slots(resource), m_maxDepth(maxDepth)
+        {
+            if (maxDepth == 0u || maxDepth > s_maxDepth)
+                throw std::runtime_error("VknFlatSpace depth must be between 1 and 8.");
+        }
+
+        Node descend(uint64_t key, uint_fast32_t depth, uint_fast32_t position)
+        {
+            if (depth + 1u > m_maxDepth)
+                throw std::runtime_error("Trying to dive too deep into VknFlatSpace. New depth > max depth.");
+            if (position > std::numeric_limits<uint8_t>::max())
+                throw std::runtime_error("Position given is out of range.");
+            return Node{this, key | (static_cast<uint64_t>(position) << (8u * depth)), static_cast<uint_least8_t>(depth + 1u)};
+        }
+
+        Node operator[](uint_fast32_t position)
+        {
+            return this->descend(0u, 0u, position);
+        }
+
+        // Read-only lookups that never add a leaf. find(d, r) is the leaf at [d][r], tryGet(d, r, s) is [d][r](s).
+        template <typename... Positions>
+        Leaf *find(Positions... positions)
+        {
+            const uint_fast32_t coords[]{static_cast<uint_fast32_t>(positions)...};
+            return this->findLeaf(coords, sizeof...(Positions));
+        }
+
+        template <typename... Positions>
+        SpaceDataType *tryGet(Positions... positions)
+        {
+            static_assert(sizeof...(Positions) > 1u, "tryGet() needs the leaf coordinates and a data position.");
+            const uint_fast32_t coords[]{static_cast<uint_fast32_t>(positions)...};
+            Leaf *leaf{this->findLeaf(coords, sizeof...(Positions) - 1u)};
+            return leaf ? leaf->getElement(coords[sizeof...(Positions) - 1u]) : nullptr;
+        }
+
+        uint_fast32_t getNumLeaves() { return m_leaves.size(); }
+        uint_fast32_t getMaxDepth() { return m_maxDepth; }
+        bool isEmpty()
+        {
+            return std::all_of(m_leaves.begin(), m_leaves.end(), [](Leaf &leaf)
+                               { return leaf.isEmpty(); });
+        }
+        std::pmr::memory_resource *getMemoryResource() { return m_leaves.get_allocator().resource(); }
     };
 
     std::vector<char> readBinaryFile(std::filesystem::path filename);
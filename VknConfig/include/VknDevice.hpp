@@ -48,6 +48,7 @@
 #include <memory>
 #include <vma/vk_mem_alloc.h>
 #include <map>
+#include <filesystem>
 
 #include "VknObject.hpp"
 #include "VknRenderpass.hpp"
@@ -94,6 +95,15 @@ namespace vkn
         uint32_t findQueueFamily(QueueType type);
         void addExtension(std::string extension);
         void setPresentable(bool presentable) { m_presentable = presentable; }
+        // Before createDevice(). The pipeline cache is seeded from and saved to a blob in directory.
+        void setPipelineCacheDir(std::filesystem::path directory) { m_pipelineCacheDir = directory; }
+        // Before createDevice(). False, with nothing enabled, if the physical device can't link pipeline
+        // libraries. Renderpasses opt in with VknRenderpass::setUsePipelineLibrary().
+        bool enablePipelineLibrary();
+        // Before createDevice(). Enables as much of VK_EXT_extended_dynamic_state/2/3 as the physical device
+        // has and returns that level, NONE if it lacks the first. Renderpasses opt in with
+        // VknRenderpass::setExtendedDynamicState().
+        VknExtendedDynamicState enableExtendedDynamicState();
 
         // Create
         VknResult createDevice();
@@ -105,10 +115,14 @@ namespace vkn
         VknRenderpass *getRenderpass(uint32_t renderpassIdx);
         VknCommandPool *getCommandPool(QueueType type);
         VkDevice *getVkDevice();
+        VkPipelineCache getPipelineCache();
         VkSemaphore &getImageAvailableSemaphores(uint32_t frameInFlight);
         VkSemaphore &getRenderFinishedSemaphores(uint32_t frameInFlight);
         VkFence &getInFlightFences(uint32_t frameInFlight);
         VknIdxs &getRelIdxs() { return m_relIdxs; }
+        bool isPipelineLibraryEnabled() { return m_pipelineLibraryEnabled; }
+        VknExtendedDynamicState getExtendedDynamicState() { return m_extendedDynamicState; }
+        const VknExtendedDynamicStateCommands &getExtendedDynamicStateCommands() { return m_extendedDynamicStateCommands; }
         VkSemaphore &getImageAvailableSemaphore(uint32_t frameInFlight);
         VkSemaphore &getRenderFinishedSemaphore(uint32_t frameInFlight);
         VkFence &getFence(uint32_t frameInFlight);
@@ -136,6 +150,8 @@ namespace vkn
         const char *const *m_extensions{nullptr};
         uint32_t m_extensionsSize{0};
         VmaVulkanFunctions m_vmaVulkanFunctions{};
+        std::filesystem::path m_pipelineCacheDir{}; // Empty keeps the cache in memory only
+        VknExtendedDynamicStateCommands m_extendedDynamicStateCommands{};
 
         // State
         bool m_createdVkDevice{false};
@@ -148,11 +164,16 @@ namespace vkn
         bool m_allocatorAdded{false};
         bool m_addedVmaFunctions{false};
         bool m_presentable{false};
+        bool m_pipelineLibraryEnabled{false};
+        VknExtendedDynamicState m_extendedDynamicState{EXTENDED_DYNAMIC_STATE_NONE};
 
         // For correct sync object retrieval
         uint32_t m_imageAvailableSemaphoreStartIdx{0};
         uint32_t m_renderFinishedSemaphoreStartIdx{0}; // Could combine with IA if strictly interleaved
         uint32_t m_inFlightFenceStartIdx{0};
         uint32_t m_maxFramesInFlightForSyncObjects{0};
+
+        void createPipelineCache();
+        void loadExtendedDynamicStateCommands();
     };
 }
\ No newline at end of file
@@ -1,12 +1,33 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <vector>
 
 #include "VknObject.hpp"
 #include "VknData.hpp"
 
 namespace vkn
 {
+    // How much of VK_EXT_extended_dynamic_state/2/3 is in use, each level includes the ones below
+    enum VknExtendedDynamicState : uint_fast32_t
+    {
+        EXTENDED_DYNAMIC_STATE_NONE = 0,
+        EXTENDED_DYNAMIC_STATE_1 = 1, // Cull mode, front face, primitive topology
+        EXTENDED_DYNAMIC_STATE_2 = 2, // Primitive restart, depth bias enable
+        EXTENDED_DYNAMIC_STATE_3 = 3  // Polygon mode
+    };
+
+    // Loaded from the device, null past the level it enabled
+    struct VknExtendedDynamicStateCommands
+    {
+        PFN_vkCmdSetCullModeEXT setCullMode{nullptr};
+        PFN_vkCmdSetFrontFaceEXT setFrontFace{nullptr};
+        PFN_vkCmdSetPrimitiveTopologyEXT setPrimitiveTopology{nullptr};
+        PFN_vkCmdSetPrimitiveRestartEnableEXT setPrimitiveRestartEnable{nullptr};
+        PFN_vkCmdSetDepthBiasEnableEXT setDepthBiasEnable{nullptr};
+        PFN_vkCmdSetPolygonModeEXT setPolygonMode{nullptr};
+    };
+
     class VknDynamicState : public VknObject
     {
     public:
@@ -15,13 +36,20 @@ namespace vkn
 
         // Config
         void addDynamicState(VkDynamicState dynamicState);
+        // Adds the states of level that aren't added yet. Their pipeline values are then set at record time.
+        void _addExtendedDynamicStates(VknExtendedDynamicState level);
 
         // Create
         VkPipelineDynamicStateCreateInfo *_fileDynamicStateCreateInfo();
 
+        // Get
+        bool hasDynamicState(VkDynamicState dynamicState);
+        VknExtendedDynamicState getExtendedDynamicState() { return m_extendedDynamicState; }
+
     private:
         // dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
         VknVector<VkDynamicState> m_dynamicStates{};
+        VknExtendedDynamicState m_extendedDynamicState{EXTENDED_DYNAMIC_STATE_NONE};
 
         // State
         bool m_filedCreateInfo{false};
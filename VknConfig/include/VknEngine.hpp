@@ -50,10 +50,25 @@
 #include <vma/vk_mem_alloc.h>
 
 #include <unordered_map>
+#include <map>
+#include <utility>
 #include <optional>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <exception>
+#include <future>
+#include <chrono>
+#include <array>
+#include <vector>
+#include <tuple>
 #include <span> // For std::span
 #include <stdexcept>
+#include <sstream>
 #include "VknData.hpp"
+#include "VknTrace.hpp"
+#include "VknPipelineCacheFile.hpp"
 
 namespace vkn
 {
@@ -130,9 +145,86 @@ namespace vkn
             throw std::runtime_error("Invalid object type passed to typeToStr().");
     } // typeToStr<T>()
 
+    // Handle types that routinely exceed 256 instances get 16-bit registry positions
+    template <typename T>
+    constexpr bool isHighCardinality()
+    {
+        return std::is_same_v<T, VkImage> || std::is_same_v<T, VkImageView> ||
+               std::is_same_v<T, VkBuffer> || std::is_same_v<T, VkFramebuffer> ||
+               std::is_same_v<T, VkPipeline> || std::is_same_v<T, VkShaderModule> ||
+               std::is_same_v<T, VkSemaphore> || std::is_same_v<T, VkFence>;
+    }
+
+    template <typename T>
+    using VknEngineIdx = std::conditional_t<isHighCardinality<T>(), uint_least16_t, uint_least8_t>;
+    template <typename T>
+    using VknEngineVector = VknVector<T, VknEngineIdx<T>>;
+    template <typename T>
+    using VknEngineIterator = VknVectorIterator<T, VknEngineIdx<T>>;
+
+    // The handle each registered type is created from and destroyed through
+    template <typename T>
+    using VknEngineParent = std::conditional_t<
+        std::is_same_v<T, VkDevice> || std::is_same_v<T, VkSurfaceKHR> || std::is_same_v<T, VkDebugUtilsMessengerEXT>,
+        VkInstance, VkDevice>;
+
+    template <typename ObjectType> // Parallel to the object vector, so shares its width
+    using VknParentVector = VknVector<VknEngineParent<ObjectType> *, VknEngineIdx<ObjectType>>;
+    template <typename ResourceType>
+    using VknAllocationVector = VknVector<VmaAllocation, VknEngineIdx<ResourceType>>;
+    template <typename ResourceType>
+    using VknAllocatorVector = VknVector<VmaAllocator *, VknEngineIdx<ResourceType>>;
+
+    template <typename... Types>
+    struct VknTypeList
+    {
+        static constexpr uint_fast32_t s_size{sizeof...(Types)};
+
+        template <typename T>
+        static constexpr uint_fast32_t indexOf()
+        {
+            constexpr bool matches[]{std::is_same_v<T, Types>...};
+            for (uint_fast32_t i = 0; i < s_size; ++i)
+                if (matches[i])
+                    return i;
+            return s_size;
+        }
+
+        template <template <typename> typename Storage>
+        using Tuple = std::tuple<Storage<Types>...>;
+
+        // Calls func.template operator()<T>() once per type, in list order
+        template <typename Func>
+        static void forEach(Func &&func)
+        {
+            (func.template operator()<Types>(), ...);
+        }
+    }; // VknTypeList
+
+    // Every type VknEngine keeps a registry for. A type's position here is its registry slot.
+    using VknEngineTypes = VknTypeList<
+        VkInstance, VkDevice, VkRenderPass, VkPipeline, VkSwapchainKHR, VkImage, VkFramebuffer, VkImageView,
+        VkDescriptorSetLayout, VkPipelineLayout, VkPhysicalDevice, VkShaderModule, VkPipelineCache, VkSurfaceKHR,
+        VkQueueFamilyProperties, VkDeviceMemory, VkDebugUtilsMessengerEXT, VkCommandPool, VkCommandBuffer *,
+        uint32_t, VkSemaphore, VkFence, VmaAllocator, VmaAllocation, VkBuffer>;
+
+    // Resolved at compile time, so an unregistered type fails to build instead of throwing at runtime
+    template <typename T>
+    constexpr uint_fast32_t typeSlot()
+    {
+        constexpr uint_fast32_t slot{VknEngineTypes::indexOf<T>()};
+        static_assert(slot < VknEngineTypes::s_size, "Type has no VknEngine registry slot. Add it to VknEngineTypes.");
+        return slot;
+    }
+
+    // Trivially copyable, so handing these out by value costs a memcpy rather than a map copy
     class VknIdxs
     {
-        std::unordered_map<std::string, uint32_t> m_data{};
+        static_assert(VknEngineTypes::s_size <= 32, "VknIdxs presence mask is 32 bits wide.");
+
+        std::array<uint32_t, VknEngineTypes::s_size> m_data{};
+        std::array<uint_least16_t, VknEngineTypes::s_size> m_generations{}; // Engine generation of each position when added
+        uint32_t m_present{0u}; // Bit typeSlot<T>() is set once a T index is added
 
     public:
         // Overloads
@@ -147,27 +239,89 @@ namespace vkn
         template <typename T>
         uint32_t &get()
         {
-            std::string vkTypeStr = typeToStr<T>();
-            if (m_data.count(vkTypeStr) == 0)
-                throw std::runtime_error("Key of type " + vkTypeStr + " not found in VknIdxs. Key may not be set yet.");
-            return m_data.at(typeToStr<T>());
+            if (!this->exists<T>())
+                throw std::runtime_error("Key of type " + typeToStr<T>() + " not found in VknIdxs. Key may not be set yet.");
+            return m_data[typeSlot<T>()];
+        }
+
+        template <typename T>
+        uint_least16_t getGeneration()
+        {
+            this->get<T>(); // Throws if missing
+            return m_generations[typeSlot<T>()];
         }
 
         // Add a new key-value pair
         template <typename T>
-        void add(uint32_t value)
+        void add(uint32_t value, uint_least16_t generation = 0u)
         {
-            m_data[typeToStr<T>()] = value;
+            m_data[typeSlot<T>()] = value;
+            m_generations[typeSlot<T>()] = generation;
+            m_present |= 1u << typeSlot<T>();
         }
 
         template <typename T>
         bool exists()
         {
-            std::string vkTypeStr = typeToStr<T>();
-            return m_data.count(vkTypeStr);
+            return m_present & (1u << typeSlot<T>());
+        }
+
+        // Apply a remap table returned by VknVector::compact()
+        template <typename T, typename RemapTable>
+        void remap(RemapTable &table)
+        {
+            uint32_t &idx = this->get<T>();
+            idx = table(idx);
+        }
+
+        // Present keys as a JSON object, used for trace args
+        std::string toJson()
+        {
+            std::string json{"{"};
+            VknEngineTypes::forEach(
+                [this, &json]<typename T>()
+                {
+                    if (this->exists<T>())
+                        json += (json.size() > 1u ? ",\"" : "\"") + typeToStr<T>() +
+                                "\":" + std::to_string(m_data[typeSlot<T>()]);
+                });
+            return json + "}";
         }
 
     }; // VknIdxs
+    static_assert(std::is_trivially_copyable_v<VknIdxs>);
+
+    // Registry snapshot for one type. Positions, not count, are what run into maxPositions.
+    struct VknTypeStats
+    {
+        std::string type{};
+        uint_fast32_t count{0};
+        uint_fast32_t positions{0}; // One past the highest position in use
+        uint_fast32_t capacity{0};
+        uint_fast32_t maxPositions{0};
+        uint_fast32_t parents{0};
+        uint_fast32_t allocations{0};
+        float fragmentation{0.0f}; // Share of positions that are holes
+    };
+
+    // VMA totals for one VmaAllocator
+    struct VknAllocatorStats
+    {
+        uint_fast32_t position{0};
+        uint_fast32_t blockCount{0};
+        uint_fast32_t allocationCount{0};
+        uint_fast32_t unusedRangeCount{0};
+        uint_fast64_t blockBytes{0};
+        uint_fast64_t allocationBytes{0};
+    };
+
+    struct VknEngineStats
+    {
+        std::vector<VknTypeStats> types{};
+        std::vector<VknAllocatorStats> allocators{};
+
+        std::string toJson() const;
+    };
 
     class VknEngine
     {
@@ -185,15 +339,18 @@ namespace vkn
 
         void shutdown();
 
+        // Registration and lookups may run on several threads, each type is guarded by its own lock. A returned
+        // reference is only valid until another registration grows the same type's storage.
         template <typename ObjectType, typename ParentType>
         uint32_t push_back(ObjectType val, ParentType *parent)
         {
-            VknVector<ObjectType> &vec{this->getVector<ObjectType>()};
-            VknVector<ParentType *> &parentVec = this->getParentVector<ObjectType, ParentType>();
-            m_pos = vec.getSize();
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            VknEngineVector<ObjectType> &vec{this->getVector<ObjectType>()};
+            VknParentVector<ObjectType> &parentVec = this->getParentVector<ObjectType, ParentType>();
+            uint32_t pos = vec.getSize();
             vec.appendOne(val);
             parentVec.appendOne(parent);
-            return m_pos;
+            return pos;
         }
 
         template <typename ObjectType, typename ParentType>
@@ -206,81 +363,111 @@ namespace vkn
         template <typename ObjectType>
         uint32_t push_back()
         {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
             ObjectType val{};
-            VknVector<ObjectType> &vec{this->getVector<ObjectType>()};
-            m_pos = vec.getSize();
+            VknEngineVector<ObjectType> &vec{this->getVector<ObjectType>()};
+            uint32_t pos = vec.getSize();
             vec.appendOne(val);
-            return m_pos;
+            return pos;
         }
 
         template <typename ObjectType>
         ObjectType &getObject(uint32_t idx)
         {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
             return this->getVector<ObjectType>()(idx);
         }
 
+        // Throws for an index whose position was removed or compacted since it was taken, in every build
         template <typename ObjectType>
         ObjectType &getObject(VknIdxs &absIdxs)
         {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            if (!this->isCurrent<ObjectType>(absIdxs))
+                throw std::runtime_error("Stale " + typeToStr<ObjectType>() + " index. Its position was removed and may have been reused.");
             return this->getVector<ObjectType>()(absIdxs.get<ObjectType>());
         }
 
+        // For handles published from another thread, which can't hold a reference across registrations
         template <typename ObjectType>
-        VknVector<ObjectType> &getVector()
+        void setObject(VknIdxs &absIdxs, ObjectType object)
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<ObjectType>{};
-            return *static_cast<VknVector<ObjectType> *>(m_objectVectors[m_vkTypeStr]);
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            this->getObject<ObjectType>(absIdxs) = object;
         }
 
-        template <typename ObjectType, typename ParentType>
-        VknVector<ParentType *> &getParentVector()
+        // Position generations are bumped on removal, so an index taken before then no longer matches
+        template <typename ObjectType>
+        uint_least16_t getGeneration(uint_fast32_t position)
+        {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            std::vector<uint_least16_t> &generations{m_generations[typeSlot<ObjectType>()]};
+            return position < generations.size() ? generations[position] : 0u;
+        }
+
+        template <typename ObjectType>
+        bool isCurrent(VknIdxs &absIdxs)
+        {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            return absIdxs.getGeneration<ObjectType>() == this->getGeneration<ObjectType>(absIdxs.get<ObjectType>());
+        }
+
+        template <typename ObjectType>
+        VknEngineVector<ObjectType> &getVector()
+        {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            m_hasObjectVector[typeSlot<ObjectType>()] = true;
+            return std::get<typeSlot<ObjectType>()>(m_objectVectors);
+        }
+
+        template <typename ObjectType, typename ParentType = VknEngineParent<ObjectType>>
+        VknParentVector<ObjectType> &getParentVector()
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            static_assert(std::is_same_v<ParentType, VknEngineParent<ObjectType>>,
+                          "ParentType does not match VknEngineParent<ObjectType>.");
+            if (!m_hasParentVector[typeSlot<ObjectType>()])
                 throw std::runtime_error("Parent vector not found!");
-            return *static_cast<VknVector<ParentType *> *>(m_parentVectors[m_vkTypeStr]);
+            return std::get<typeSlot<ObjectType>()>(m_parentVectors);
         }
 
         template <typename ObjectType, typename ParentType>
         ParentType *getParentPointer(size_t idx)
         {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
             return this->getParentVector<ObjectType, ParentType>()(idx);
         }
 
         template <typename ObjectType>
-        VknVectorIterator<ObjectType> getVectorSlice(uint32_t startIdx, uint32_t length)
+        VknEngineIterator<ObjectType> getVectorSlice(uint32_t startIdx, uint32_t length)
         {
-            VknVector<ObjectType> &vec = this->getVector<ObjectType>();
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            VknEngineVector<ObjectType> &vec = this->getVector<ObjectType>();
             return vec.getSlice(startIdx, length);
         }
 
         template <typename ObjectType>
         uint32_t getVectorSize()
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            if (!m_hasObjectVector[typeSlot<ObjectType>()])
                 return 0;
-            return static_cast<VknVector<ObjectType> *>(m_objectVectors[m_vkTypeStr])->getNumPositions();
+            return std::get<typeSlot<ObjectType>()>(m_objectVectors).getNumPositions();
         }
 
         template <typename VknObjectType, typename VkObjectType, typename VkParentType>
         VknObjectType &addNewVknObject(uint32_t idx, std::list<VknObjectType> &objList,
                                        VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
             if (idx != objList.size())
                 throw std::runtime_error("List index out of range or incorrect.");
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
-                m_parentVectors[m_vkTypeStr] = new VknVector<VkParentType>{};
+            this->registerParentVector<VkObjectType>();
 
             VknIdxs newRelIdxs = relIdxs;
             VknIdxs newAbsIdxs = absIdxs;
             VkParentType *parent = &this->getObject<VkParentType>(absIdxs);
-            newAbsIdxs.add<VkObjectType>(this->push_back<VkObjectType, VkParentType>(parent));
+            this->addIdx<VkObjectType>(newAbsIdxs, this->push_back<VkObjectType, VkParentType>(parent));
             newRelIdxs.add<VkObjectType>(objList.size());
             return objList.emplace_back(newRelIdxs, newAbsIdxs);
         }
@@ -289,15 +476,12 @@ namespace vkn
         VknObjectType &addNewVknObject(uint32_t idx, std::list<VknObjectType> &objList,
                                        VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
             if (idx != objList.size())
                 throw std::runtime_error("List index out of range or incorrect.");
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-
             VknIdxs newRelIdxs = relIdxs;
             VknIdxs newAbsIdxs = absIdxs;
-            newAbsIdxs.add<VkObjectType>(this->push_back<VkObjectType>());
+            this->addIdx<VkObjectType>(newAbsIdxs, this->push_back<VkObjectType>());
             newRelIdxs.add<VkObjectType>(objList.size());
             return objList.emplace_back(newRelIdxs, newAbsIdxs);
         }
@@ -306,23 +490,22 @@ namespace vkn
         uint32_t addNewVknObjects(uint32_t count, std::list<VknObjectType> &objList,
                                   VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
-                m_parentVectors[m_vkTypeStr] = new VknVector<VkParentType>{};
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            this->registerParentVector<VkObjectType>();
 
-            VknVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
+            VknEngineVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
             uint32_t startPos = vkObjectVec.getDefragPos(count);
-            VknVector<VkParentType *> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
+            VknParentVector<VkObjectType> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
+            vkObjectVec.reserve(vkObjectVec.getSize() + count);
+            vkParentVec.reserve(vkParentVec.getSize() + count);
             VknIdxs newRelIdxs = relIdxs;
             VknIdxs newAbsIdxs = absIdxs;
-            for (m_iter = 0; m_iter < count; ++m_iter)
+            for (uint_fast32_t i = 0; i < count; ++i)
             {
-                newAbsIdxs.add<VkObjectType>(startPos + m_iter);
-                vkObjectVec.insert(startPos + m_iter, VkObjectType{});
+                this->addIdx<VkObjectType>(newAbsIdxs, startPos + i);
+                vkObjectVec.insert(startPos + i, VkObjectType{});
                 newRelIdxs.add<VkObjectType>(objList.size());
-                vkParentVec.insert(startPos + m_iter, &this->getObject<VkParentType>(absIdxs));
+                vkParentVec.insert(startPos + i, &this->getObject<VkParentType>(absIdxs));
                 objList.emplace_back(newRelIdxs, newAbsIdxs);
             }
             return startPos;
@@ -332,23 +515,23 @@ namespace vkn
         uint32_t addNewVknObjects(uint32_t count, VknVector<VknObjectType> &objList,
                                   VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
-                m_parentVectors[m_vkTypeStr] = new VknVector<VkParentType>{};
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            this->registerParentVector<VkObjectType>();
 
-            VknVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
+            VknEngineVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
             uint_fast32_t startPos{vkObjectVec.getDefragPos(count)};
-            VknVector<VkParentType *> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
+            VknParentVector<VkObjectType> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
+            vkObjectVec.reserve(vkObjectVec.getSize() + count);
+            vkParentVec.reserve(vkParentVec.getSize() + count);
+            objList.reserve(objList.getSize() + count);
             VknIdxs newRelIdxs = relIdxs;
             VknIdxs newAbsIdxs = absIdxs;
-            for (m_iter = 0; m_iter < count; ++m_iter)
+            for (uint_fast32_t i = 0; i < count; ++i)
             {
-                newAbsIdxs.add<VkObjectType>(startPos + m_iter);
-                vkObjectVec.insert(startPos + m_iter, VkObjectType{});
+                this->addIdx<VkObjectType>(newAbsIdxs, startPos + i);
+                vkObjectVec.insert(startPos + i, VkObjectType{});
                 newRelIdxs.add<VkObjectType>(objList.size());
-                vkParentVec.insert(startPos + m_iter, &this->getObject<VkParentType>(absIdxs));
+                vkParentVec.insert(startPos + i, &this->getObject<VkParentType>(absIdxs));
                 objList.appendOne(VknObjectType{newRelIdxs, newAbsIdxs});
             }
             return startPos;
@@ -358,18 +541,16 @@ namespace vkn
         uint32_t addNewVknObjects(uint32_t count, std::list<VknObjectType> &objList,
                                   VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-
-            VknVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            VknEngineVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
             uint32_t startPos = vkObjectVec.getDefragPos(count);
+            vkObjectVec.reserve(vkObjectVec.getSize() + count);
             VknIdxs newRelIdxs = relIdxs;
             VknIdxs newAbsIdxs = absIdxs;
-            for (m_iter = 0; m_iter < count; ++m_iter)
+            for (uint_fast32_t i = 0; i < count; ++i)
             {
-                newAbsIdxs.add<VkObjectType>(startPos + m_iter);
-                vkObjectVec.insert(startPos + m_iter, VkObjectType{});
+                this->addIdx<VkObjectType>(newAbsIdxs, startPos + i);
+                vkObjectVec.insert(startPos + i, VkObjectType{});
                 newRelIdxs.add<VkObjectType>(objList.size());
                 objList.emplace_back(newRelIdxs, newAbsIdxs);
             }
@@ -379,53 +560,44 @@ namespace vkn
         template <typename VknObjectType, typename VkObjectType, typename VkParentType>
         void demolishVknObjects(uint32_t startPos, uint32_t count, std::list<VknObjectType> &objList)
         {
-            VknVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
-            VknVector<VkParentType *> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
-            for (m_iter = 0; m_iter < objList.size(); ++m_iter)
-                getListElement(m_iter, objList)->demolish();
+            for (uint_fast32_t i = 0; i < objList.size(); ++i) // Before locking, demolish() reaches other types
+                getListElement(i, objList)->demolish();
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            VknEngineVector<VkObjectType> &vkObjectVec = this->getVector<VkObjectType>();
+            VknParentVector<VkObjectType> &vkParentVec = this->getParentVector<VkObjectType, VkParentType>();
             vkObjectVec.remove(startPos, count);
             vkParentVec.remove(startPos, count);
+            for (uint_fast32_t i = 0; i < count; ++i)
+                this->retirePosition<VkObjectType>(startPos + i);
             objList.clear();
         }
 
         template <typename VkObjectType, typename VkParentType>
         VkObjectType &addNewObject(VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
-                m_parentVectors[m_vkTypeStr] = new VknVector<VkParentType>{};
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            this->registerParentVector<VkObjectType>();
 
             VkParentType *parent = &this->getObject<VkParentType>(absIdxs);
-            absIdxs.add<VkObjectType>(this->push_back<VkObjectType, VkParentType>(parent));
+            this->addIdx<VkObjectType>(absIdxs, this->push_back<VkObjectType, VkParentType>(parent));
             return this->getObject<VkObjectType>(absIdxs);
         }
 
         template <typename VkObjectType>
         VkObjectType &addNewObject(VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkObjectType>{};
-
-            absIdxs.add<VkObjectType>(this->push_back<VkObjectType>());
+            std::scoped_lock lock{this->typeLock<VkObjectType>()};
+            this->addIdx<VkObjectType>(absIdxs, this->push_back<VkObjectType>());
             return this->getObject<VkObjectType>(absIdxs);
         }
 
         template <typename VkResourceType>
         VmaAllocation &addNewAllocation(VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkResourceType>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkResourceType>{};
-            if (m_parentVectors.find(m_vkTypeStr) == m_parentVectors.end())
-                m_parentVectors[m_vkTypeStr] = new VknVector<VmaAllocator>{};
-            if (m_allocations.find(m_vkTypeStr) == m_allocations.end())
-                m_allocations[m_vkTypeStr] = new VknVector<VmaAllocation>{};
-
-            VknVector<VmaAllocation> &allocationVec = *static_cast<VknVector<VmaAllocation> *>(m_allocations[m_vkTypeStr]);
-            VknVector<VmaAllocator *> &allocatorVec = *static_cast<VknVector<VmaAllocator *> *>(m_parentVectors[m_vkTypeStr]);
+            std::scoped_lock lock{this->typeLock<VkResourceType>()};
+            m_hasAllocationVector[typeSlot<VkResourceType>()] = true;
+            VknAllocationVector<VkResourceType> &allocationVec = std::get<typeSlot<VkResourceType>()>(m_allocations);
+            VknAllocatorVector<VkResourceType> &allocatorVec = std::get<typeSlot<VkResourceType>()>(m_allocators);
             if (!absIdxs.exists<VmaAllocation>())
                 absIdxs.add<VmaAllocation>(allocationVec.getDefragPos(1u));
             allocationVec.insert(absIdxs.get<VmaAllocation>(), VmaAllocation{});
@@ -434,13 +606,21 @@ namespace vkn
         }
 
         template <typename VkResourceType>
-        VknVector<VmaAllocation> &getAllocationVector()
+        VknAllocationVector<VkResourceType> &getAllocationVector()
         {
-            m_vkTypeStr = typeToStr<VkResourceType>();
-            if (m_allocations.find(m_vkTypeStr) == m_allocations.end())
+            std::scoped_lock lock{this->typeLock<VkResourceType>()};
+            if (!m_hasAllocationVector[typeSlot<VkResourceType>()])
                 throw std::runtime_error("Allocation vector not found!");
+            return std::get<typeSlot<VkResourceType>()>(m_allocations);
+        }
 
-            return *static_cast<VknVector<VmaAllocation> *>(m_allocations[m_vkTypeStr]);
+        template <typename VkResourceType>
+        VmaAllocator *getAllocator(uint_fast32_t pos)
+        {
+            std::scoped_lock lock{this->typeLock<VkResourceType>()};
+            if (!m_hasAllocationVector[typeSlot<VkResourceType>()])
+                throw std::runtime_error("Allocation vector not found!");
+            return std::get<typeSlot<VkResourceType>()>(m_allocators)(pos);
         }
 
         template <typename VkResourceType>
@@ -457,46 +637,37 @@ namespace vkn
 
         VkInstance *addVkInstance(VknIdxs &relIdxs, VknIdxs &absIdxs)
         {
-            m_vkTypeStr = typeToStr<VkInstance>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkInstance>{};
-
-            VknVector<VkInstance> &vec{this->getVector<VkInstance>()};
-            m_pos = vec.getSize();
-            if (m_pos != 0)
+            std::scoped_lock lock{this->typeLock<VkInstance>()};
+            VknEngineVector<VkInstance> &vec{this->getVector<VkInstance>()};
+            uint32_t pos = vec.getSize();
+            if (pos != 0)
                 throw std::runtime_error("VkInstance already added.");
             vec.appendOne(VkInstance{VK_NULL_HANDLE});
 
-            absIdxs.add<VkInstance>(m_pos);
-            relIdxs.add<VkInstance>(m_pos);
-            return &vec(m_pos);
+            absIdxs.add<VkInstance>(pos);
+            relIdxs.add<VkInstance>(pos);
+            return &vec(pos);
         }
 
         VkCommandBuffer *addVkCommandBuffers(VknIdxs &absIdxs, uint32_t numCommandBuffers)
         {
-            m_vkTypeStr = typeToStr<VkCommandBuffer *>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<VkCommandBuffer *>{};
-            m_vkTypeStr = typeToStr<uint32_t>();
-            if (m_objectVectors.find(m_vkTypeStr) == m_objectVectors.end())
-                m_objectVectors[m_vkTypeStr] = new VknVector<uint32_t>{};
-
-            absIdxs.add<VkCommandBuffer *>(this->getVectorSize<VkCommandBuffer *>());
-            VknVector<VkCommandBuffer *> &cmdBufferVec{this->getVector<VkCommandBuffer *>()};
-            VknVector<uint32_t> &numBuffersVec{this->getVector<uint32_t>()};
+            std::scoped_lock lock{this->typeLock<VkCommandBuffer *>(), this->typeLock<uint32_t>()};
+            this->addIdx<VkCommandBuffer *>(absIdxs, this->getVectorSize<VkCommandBuffer *>());
+            VknEngineVector<VkCommandBuffer *> &cmdBufferVec{this->getVector<VkCommandBuffer *>()};
+            VknEngineVector<uint32_t> &numBuffersVec{this->getVector<uint32_t>()};
             uint32_t poolIdx{absIdxs.get<VkCommandPool>()};
             numBuffersVec.insert(poolIdx, numCommandBuffers);
             cmdBufferVec.insert(poolIdx, new VkCommandBuffer[numCommandBuffers]);
-            for (m_iter = 0; m_iter < numCommandBuffers; ++m_iter)
-                cmdBufferVec(poolIdx)[m_iter] = VK_NULL_HANDLE;
+            for (uint_fast32_t i = 0; i < numCommandBuffers; ++i)
+                cmdBufferVec(poolIdx)[i] = VK_NULL_HANDLE;
             return cmdBufferVec(poolIdx);
         }
 
         template <typename T>
         bool exists()
         {
-            m_vkTypeStr = typeToStr<T>();
-            return m_objectVectors.count(m_vkTypeStr);
+            std::scoped_lock lock{this->typeLock<T>()};
+            return m_hasObjectVector[typeSlot<T>()];
         }
 
         template <typename VkObjectType, typename VkParentType>
@@ -504,56 +675,182 @@ namespace vkn
         {
             if (this->exists<VkObjectType>())
             {
-                for (m_iter = 0; m_iter < this->getVectorSize<VkObjectType>(); ++m_iter)
+                VknEngineVector<VkObjectType> &objects{this->getVector<VkObjectType>()};
+                VknTraceScope trace{"Demolish " + typeToStr<VkObjectType>(), "demolish",
+                                    this->traceArgs<VkObjectType>(objects.getSize())};
+                for (uint_fast32_t i = 0; i < objects.getSize(); ++i)
                     func(
-                        *this->getParentPointer<VkObjectType, VkParentType>(m_iter),
-                        this->getObject<VkObjectType>(m_iter), nullptr);
-                this->deleteVectors<VkObjectType, VkParentType>();
+                        *this->getParentPointer<VkObjectType, VkParentType>(objects.getPosition(i)),
+                        objects.begin()[i], nullptr);
+                this->deleteVectors<VkObjectType>();
             }
         }
 
-        // Removes an object and its parent from tracking. Used for mid-lifecycle destruction.
-        void removeImageView(uint32_t position)
+        // Packs the positions of ObjectType and its parent pointers, if it has any. Anything holding a VknIdxs
+        // for ObjectType must be remapped with the returned table and the new generation of its position.
+        template <typename ObjectType>
+        VknVector<uint_least32_t, VknEngineIdx<ObjectType>> compactVector()
+        {
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            uint_fast32_t numPositions{this->getVector<ObjectType>().getNumPositions()}; // Before packing
+            VknVector<uint_least32_t, VknEngineIdx<ObjectType>> remap{this->getVector<ObjectType>().compact()};
+            if (m_hasParentVector[typeSlot<ObjectType>()])
+                this->getParentVector<ObjectType>().compact(); // Same positions, so same table
+
+            // Every position moves past any generation seen there or moved in, so no index taken before
+            // compaction is current until it's remapped. Positions past the new end keep their bumped value.
+            std::vector<uint_least16_t> &generations{m_generations[typeSlot<ObjectType>()]};
+            std::vector<uint_least16_t> newGenerations(std::max<size_t>(generations.size(), numPositions), 0u);
+            for (uint_fast32_t i = 0; i < generations.size(); ++i)
+                newGenerations[i] = generations[i];
+            for (uint_fast32_t i = 0; i < generations.size(); ++i)
+                if (remap.exists(i))
+                    newGenerations[remap(i)] = std::max(newGenerations[remap(i)], generations[i]);
+            for (auto &generation : newGenerations)
+                ++generation;
+            generations = std::move(newGenerations);
+            return remap;
+        }
+
+        // Removes an object and its parent from tracking. Used for mid-lifecycle destruction. The position
+        // may be reused, but indices taken before the removal fail isCurrent().
+        template <typename ObjectType>
+        void removeObject(uint32_t position)
         {
-            // Remove the handle from the main vector, freeing the slot.
-            getVector<VkImageView>().remove(position);
-            // Also remove the corresponding parent pointer to keep vectors in sync.
-            getParentVector<VkImageView, VkDevice>().remove(position);
+            std::scoped_lock lock{this->typeLock<ObjectType>()};
+            this->getVector<ObjectType>().remove(position);
+            if (m_hasParentVector[typeSlot<ObjectType>()])
+                this->getParentVector<ObjectType>().remove(position);
+            this->retirePosition<ObjectType>(position);
         }
 
+        void removeImageView(uint32_t position)
+        {
+            this->removeObject<VkImageView>(position);
+        }
+
+        // Deferred destruction. Retired handles are tagged with the serial of the last submitted frame, which
+        // may still be using them, and destroyed once a fence for that serial or a later one has signaled.
+        void setFrameSerial(uint_fast64_t serial);
+        void retire(VkDevice device, std::function<void()> destroy);
+        void destroyRetired(uint_fast64_t completedSerial);
+        void destroyRetired(VkDevice device); // Everything retired from device, which must be idle
+        // Background work using device, such as async pipeline builds. Waited on before the device is demolished.
+        void addDeviceWork(VkDevice device, std::shared_future<void> work);
+
+        // Only registries in use are reported. Each type is locked while it is read, so the snapshot is
+        // consistent per type but not across types.
+        VknEngineStats collectStats();
+
+        // Pipelines shared by 128-bit content hash, see VknInfos::hashGfxPipeline(). Equal hashes are trusted as
+        // equal content, see VknHasher. A hit from findPipeline() takes a reference, and releasePipeline() is
+        // true once the caller holds the last one and should destroy it. Registering returns the pipeline that
+        // won, with a reference taken, if another build registered the same hash first. The caller then
+        // destroys its own.
+        VkPipeline findPipeline(VkDevice device, VknHash hash);
+        VkPipeline registerPipeline(VkDevice device, VknHash hash, VkPipeline pipeline);
+        bool releasePipeline(VkPipeline pipeline);
+        // Graphics pipeline library parts by part hash, see VknInfos::hashGfxPipelinePart(). Kept until their
+        // device is demolished. Registering returns the part that won if another thread registered one first,
+        // in which case the caller destroys its own.
+        VkPipeline findPipelineLibrary(VkDevice device, VknHash hash);
+        VkPipeline registerPipelineLibrary(VkDevice device, VknHash hash, VkPipeline library);
+
+        // A cache with a path is saved there when its device is demolished
+        void setPipelineCachePath(VkPipelineCache cache, std::filesystem::path path);
+        VkPipelineCache getPipelineCache(VkDevice *device); // VK_NULL_HANDLE if device has none
+
     private:
-        std::unordered_map<std::string, void *> m_objectVectors{};
-        std::unordered_map<std::string, void *> m_parentVectors{};
-        std::unordered_map<std::string, void *> m_allocations{};
+        // Indexed by typeSlot<T>(); the flags mark which registries are in use
+        VknEngineTypes::Tuple<VknEngineVector> m_objectVectors{};
+        VknEngineTypes::Tuple<VknParentVector> m_parentVectors{};
+        VknEngineTypes::Tuple<VknAllocationVector> m_allocations{};
+        VknEngineTypes::Tuple<VknAllocatorVector> m_allocators{}; // Parallel to m_allocations
+        std::array<bool, VknEngineTypes::s_size> m_hasObjectVector{};
+        std::array<bool, VknEngineTypes::s_size> m_hasParentVector{};
+        std::array<bool, VknEngineTypes::s_size> m_hasAllocationVector{};
         void *m_emptyVec{new VknVector<size_t>()};
 
-        // Allocate once, reuse
-        uint_fast32_t m_iter{0};
-        uint_fast32_t m_pos{0};
-        std::string m_vkTypeStr{"LongStrNoReallocation!!"};
-        std::string m_vkParentTypeStr{"LongStrNoReallocation!!"};
+        std::array<std::vector<uint_least16_t>, VknEngineTypes::s_size> m_generations{}; // Indexed by position
+        // One lock per registry slot. Recursive because registration calls back into the getters. A type's lock
+        // is only ever held while taking its parent's, never the reverse, so the parent graph orders them.
+        std::array<std::recursive_mutex, VknEngineTypes::s_size> m_typeLocks{};
+
+        struct VknRetired
+        {
+            VkDevice device;
+            uint_fast64_t serial;
+            std::function<void()> destroy;
+        };
+        std::deque<VknRetired> m_retired{}; // Serials never decrease front to back
+        std::mutex m_retiredLock{};
+        uint_fast64_t m_frameSerial{0};
+        std::vector<std::pair<VkDevice, std::shared_future<void>>> m_deviceWork{};
+        std::mutex m_deviceWorkLock{};
+
+        struct VknSharedPipeline
+        {
+            VkDevice device;
+            VknHash hash;
+            uint_fast32_t refs;
+        };
+        std::map<std::pair<VkDevice, VknHash>, VkPipeline> m_pipelinesByHash{}; // Guarded by VkPipeline's lock
+        std::unordered_map<VkPipeline, VknSharedPipeline> m_sharedPipelines{};
+        std::map<std::pair<VkDevice, VknHash>, VkPipeline> m_pipelineLibraries{}; // Guarded by VkPipeline's lock
 
         // State
         bool m_poweredOn{true}; // State to track if shutdown has been called
-        /*VknVector<VkPipelineCache> pipelineCaches{};*/
+        std::unordered_map<VkPipelineCache, std::filesystem::path> m_pipelineCachePaths{}; // Guarded by VkPipelineCache's lock
 
         // Helper functions to get extension function pointers
         void demolishDebugUtilsMessengerEXT(
             VkInstance instance, VkDebugUtilsMessengerEXT debugMessenger, const VkAllocationCallbacks *pAllocator);
 
-        template <typename ObjectType, typename ParentType>
+        // Handle type and count of a demolish pass, empty unless tracing. Counts span all parents.
+        template <typename ObjectType>
+        std::string traceArgs(uint_fast32_t count)
+        {
+            if (!VknTrace::isEnabled())
+                return "";
+            return "{\"type\":\"" + typeToStr<ObjectType>() + "\",\"count\":" + std::to_string(count) + "}";
+        }
+
+        template <typename ObjectType>
+        std::recursive_mutex &typeLock()
+        {
+            return m_typeLocks[typeSlot<ObjectType>()];
+        }
+
+        template <typename ObjectType>
+        void addIdx(VknIdxs &absIdxs, uint32_t position)
+        {
+            absIdxs.add<ObjectType>(position, this->getGeneration<ObjectType>(position));
+        }
+
+        template <typename ObjectType>
+        void retirePosition(uint_fast32_t position)
+        {
+            std::vector<uint_least16_t> &generations{m_generations[typeSlot<ObjectType>()]};
+            if (position >= generations.size())
+                generations.resize(position + 1u, 0u);
+            ++generations[position];
+        }
+
+        template <typename ObjectType>
+        VknParentVector<ObjectType> &registerParentVector()
+        {
+            m_hasParentVector[typeSlot<ObjectType>()] = true;
+            return std::get<typeSlot<ObjectType>()>(m_parentVectors);
+        }
+
+        template <typename ObjectType>
         void deleteVectors()
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) != m_objectVectors.end())
+            this->deleteVector<ObjectType>();
+            if (m_hasParentVector[typeSlot<ObjectType>()])
             {
-                delete static_cast<VknVector<ObjectType> *>(m_objectVectors[m_vkTypeStr]);
-                m_objectVectors.erase(m_vkTypeStr);
-            }
-            if (m_parentVectors.find(m_vkTypeStr) != m_parentVectors.end())
-            {
-                delete static_cast<VknVector<ParentType *> *>(m_parentVectors[m_vkTypeStr]);
-                m_parentVectors.erase(m_vkTypeStr);
+                std::get<typeSlot<ObjectType>()>(m_parentVectors) = VknParentVector<ObjectType>{};
+                m_hasParentVector[typeSlot<ObjectType>()] = false;
             }
         }
 
@@ -562,8 +859,10 @@ namespace vkn
         {
             if (this->exists<VkObjectType>())
             {
-                for (m_iter = 0; m_iter < this->getVectorSize<VkObjectType>(); ++m_iter)
-                    func(this->getObject<VkObjectType>(m_iter));
+                VknTraceScope trace{"Demolish " + typeToStr<VkObjectType>(), "demolish",
+                                    this->traceArgs<VkObjectType>(this->getVector<VkObjectType>().getSize())};
+                for (auto &object : this->getVector<VkObjectType>())
+                    func(object);
                 this->deleteVector<VkObjectType>();
             }
         }
@@ -573,57 +872,100 @@ namespace vkn
         {
             if (this->exists<VkObjectType>())
             {
-                for (m_iter = 0; m_iter < this->getVectorSize<VkObjectType>(); ++m_iter)
+                VknEngineVector<VkObjectType> &objects{this->getVector<VkObjectType>()};
+                VknTraceScope trace{"Demolish " + typeToStr<VkObjectType>(), "demolish",
+                                    this->traceArgs<VkObjectType>(objects.getSize())};
+                for (uint_fast32_t i = 0; i < objects.getSize(); ++i)
                     func(
-                        *this->getParentPointer<VkObjectType, VkParentType>(m_iter),
-                        this->getObject<VkObjectType>(m_iter), nullptr);
-                this->deleteVectors<VkObjectType, VkParentType>();
+                        *this->getParentPointer<VkObjectType, VkParentType>(objects.getPosition(i)),
+                        objects.begin()[i], nullptr);
+                this->deleteVectors<VkObjectType>();
             }
         }
 
-        template <typename VkObjectType>
-        void demolishAllocations(std::function<void(VmaAllocator, VkObjectType, VmaAllocation)> func)
-        {
-            if (this->exists<VkObjectType>())
+        // Device teardown. Only reads the registries, so different devices can run it on separate threads.
+        void demolishDevice(VkDevice *device);
+
+        // Batched over contiguous storage, destroying only the objects created from device
+        template <typename VkObjectType, typename DestroyFunc>
+        void demolishChildren(VkDevice *device, DestroyFunc destroy)
+        {
+            if (!m_hasObjectVector[typeSlot<VkObjectType>()])
+                return;
+            VknEngineVector<VkObjectType> &objects{std::get<typeSlot<VkObjectType>()>(m_objectVectors)};
+            VknParentVector<VkObjectType> &parents{std::get<typeSlot<VkObjectType>()>(m_parentVectors)};
+            VknTraceScope trace{"Demolish " + typeToStr<VkObjectType>(), "demolish",
+                                this->traceArgs<VkObjectType>(objects.getSize())};
+            VkObjectType *object{objects.begin()};
+            uint_fast32_t i{0};
+            for (/*i=0*/; i < objects.getSize(); ++i)
+                if (parents(objects.getPosition(i)) == device)
+                    destroy(*device, object[i], nullptr);
+        }
+
+        template <typename VkObjectType, typename DestroyFunc>
+        void demolishChildAllocations(std::span<VmaAllocator *const> allocators, DestroyFunc destroy)
+        {
+            if (!m_hasAllocationVector[typeSlot<VkObjectType>()])
+                return;
+            VknEngineVector<VkObjectType> &objects{std::get<typeSlot<VkObjectType>()>(m_objectVectors)};
+            VknAllocationVector<VkObjectType> &allocations{std::get<typeSlot<VkObjectType>()>(m_allocations)};
+            VknAllocatorVector<VkObjectType> &objectAllocators{std::get<typeSlot<VkObjectType>()>(m_allocators)};
+            VknTraceScope trace{"Demolish " + typeToStr<VkObjectType>(), "demolish",
+                                this->traceArgs<VkObjectType>(objects.getSize())};
+            uint_fast32_t i{0};
+            uint_fast32_t pos{0};
+            VmaAllocator **allocator{nullptr};
+            for (/*i=0*/; i < objects.getSize(); ++i)
             {
-                for (m_iter = 0; m_iter < this->getVectorSize<VkObjectType>(); ++m_iter)
-                {
-                    VmaAllocation *allocation = this->getAllocation<VkObjectType>(m_iter);
-                    VmaAllocator *allocator = this->getParentPointer<VkObjectType, VmaAllocator>(m_iter);
-                    VkObjectType &vkObject = this->getObject<VkObjectType>(m_iter);
-
-                    func(*allocator, vkObject, *allocation);
-                }
-
-                this->deleteVectors<VkObjectType, VmaAllocator>();
-                this->deleteAllocationVector<VkObjectType>();
+                pos = objects.getPosition(i);
+                allocator = objectAllocators.getElement(pos);
+                if (allocator && std::find(allocators.begin(), allocators.end(), *allocator) != allocators.end())
+                    destroy(**allocator, objects.begin()[i], allocations(pos));
             }
         }
 
-        void demolishCommandBuffers()
+        void demolishChildCommandBuffers(VkDevice *device)
         {
-            if (this->exists<VkCommandBuffer *>())
+            if (!m_hasObjectVector[typeSlot<VkCommandBuffer *>()])
+                return;
+            VknEngineVector<VkCommandBuffer *> &cmdBuffers{std::get<typeSlot<VkCommandBuffer *>()>(m_objectVectors)};
+            VknEngineVector<VkCommandPool> &pools{std::get<typeSlot<VkCommandPool>()>(m_objectVectors)};
+            VknParentVector<VkCommandPool> &poolParents{std::get<typeSlot<VkCommandPool>()>(m_parentVectors)};
+            VknEngineVector<uint32_t> &numBuffers{std::get<typeSlot<uint32_t>()>(m_objectVectors)};
+            VknTraceScope trace{"Demolish " + typeToStr<VkCommandBuffer *>(), "demolish",
+                                this->traceArgs<VkCommandBuffer *>(cmdBuffers.getSize())};
+            uint_fast32_t i{0};
+            uint_fast32_t poolPos{0};
+            for (/*i=0*/; i < cmdBuffers.getSize(); ++i)
             {
-                for (m_iter = 0; m_iter < this->getVectorSize<VkCommandBuffer *>(); ++m_iter)
-                    vkFreeCommandBuffers(
-                        *this->getParentPointer<VkCommandPool, VkDevice>(m_iter),
-                        this->getObject<VkCommandPool>(m_iter),
-                        this->getObject<uint32_t>(m_iter),
-                        this->getObject<VkCommandBuffer *>(m_iter));
-                for (m_iter = 0; m_iter < this->getVectorSize<VkCommandBuffer *>(); ++m_iter)
-                    delete[] this->getObject<VkCommandBuffer *>(m_iter);
-                this->deleteVector<VkCommandBuffer *>();
+                poolPos = cmdBuffers.getPosition(i); // Stored at their pool's position
+                if (poolParents(poolPos) != device)
+                    continue;
+                vkFreeCommandBuffers(*device, pools(poolPos), numBuffers(poolPos), cmdBuffers.begin()[i]);
+                delete[] cmdBuffers.begin()[i];
             }
         }
 
-        void demolishDevices()
+        // VmaAllocator sits in the object registries with a VkDevice parent like any other child
+        std::vector<VmaAllocator *> getChildAllocators(VkDevice *device)
         {
-            if (this->exists<VkDevice>())
-            {
-                for (auto &device : this->getVector<VkDevice>())
-                    vkDestroyDevice(device, VK_NULL_HANDLE);
-                this->deleteVectors<VkDevice, VkInstance>();
-            }
+            std::vector<VmaAllocator *> allocators{};
+            if (!m_hasObjectVector[typeSlot<VmaAllocator>()])
+                return allocators;
+            VknEngineVector<VmaAllocator> &objects{std::get<typeSlot<VmaAllocator>()>(m_objectVectors)};
+            VknParentVector<VmaAllocator> &parents{std::get<typeSlot<VmaAllocator>()>(m_parentVectors)};
+            uint_fast32_t i{0};
+            for (/*i=0*/; i < objects.getSize(); ++i)
+                if (parents(objects.getPosition(i)) == device)
+                    allocators.push_back(&objects.begin()[i]);
+            return allocators;
+        }
+
+        template <typename... ObjectTypes>
+        void deleteAllVectors()
+        {
+            (this->deleteVectors<ObjectTypes>(), ...);
         }
 
         void demolishInstance()
@@ -633,35 +975,25 @@ namespace vkn
             this->deleteVector<VkInstance>();
         }
 
-        void demolishAllocators()
-        {
-            if (this->exists<VmaAllocator>())
-            {
-                for (m_iter = 0; m_iter < this->getVectorSize<VmaAllocator>(); ++m_iter)
-                    vmaDestroyAllocator(this->getObject<VmaAllocator>(m_iter));
-                this->deleteVector<VmaAllocator>();
-            }
-        }
-
         template <typename ObjectType>
         void deleteVector()
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_objectVectors.find(m_vkTypeStr) != m_objectVectors.end())
+            if (m_hasObjectVector[typeSlot<ObjectType>()])
             {
-                delete static_cast<VknVector<ObjectType> *>(m_objectVectors[m_vkTypeStr]);
-                m_objectVectors.erase(m_vkTypeStr);
+                std::get<typeSlot<ObjectType>()>(m_objectVectors) = VknEngineVector<ObjectType>{};
+                m_generations[typeSlot<ObjectType>()].clear();
+                m_hasObjectVector[typeSlot<ObjectType>()] = false;
             }
         }
 
         template <typename ObjectType>
         void deleteAllocationVector()
         {
-            m_vkTypeStr = typeToStr<ObjectType>();
-            if (m_allocations.find(m_vkTypeStr) != m_allocations.end())
+            if (m_hasAllocationVector[typeSlot<ObjectType>()])
             {
-                delete static_cast<VknVector<VmaAllocation> *>(m_allocations[m_vkTypeStr]);
-                m_allocations.erase(m_vkTypeStr);
+                std::get<typeSlot<ObjectType>()>(m_allocations) = VknAllocationVector<ObjectType>{};
+                std::get<typeSlot<ObjectType>()>(m_allocators) = VknAllocatorVector<ObjectType>{};
+                m_hasAllocationVector[typeSlot<ObjectType>()] = false;
             }
         }
     }; // VknEngine
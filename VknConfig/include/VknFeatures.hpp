@@ -76,6 +76,10 @@ namespace vkn
         VkPhysicalDeviceMultiviewFeatures m_multiview{};
         VkPhysicalDevice16BitStorageFeatures m_storage16bit{};
         VkPhysicalDeviceProtectedMemoryFeatures m_protectedMemory{};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT m_graphicsPipelineLibrary{};
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT m_extendedDynamicState{};
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT m_extendedDynamicState2{};
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT m_extendedDynamicState3{};
 
     public:
         VknFeatures2() = default;
@@ -89,6 +93,18 @@ namespace vkn
 
         // Enable Protected Memory.
         bool protectedMemory(bool toggle = false);
+
+        // Enable Graphics Pipeline Libraries. Needs VK_EXT_graphics_pipeline_library.
+        bool graphicsPipelineLibrary(bool toggle = false);
+
+        // Enable Extended Dynamic State. Needs VK_EXT_extended_dynamic_state.
+        bool extendedDynamicState(bool toggle = false);
+
+        // Enable Extended Dynamic State 2. Needs VK_EXT_extended_dynamic_state2.
+        bool extendedDynamicState2(bool toggle = false);
+
+        // Enable the dynamic polygon mode of Extended Dynamic State 3. Needs VK_EXT_extended_dynamic_state3.
+        bool extendedDynamicState3PolygonMode(bool toggle = false);
     };
 
     class VknFeatures
@@ -88,7 +88,7 @@ namespace vkn
         } // Add getter
         bool isSwapchainImage(uint32_t i);
         bool hasSwapchainImage();
-        VknVectorIterator<VkImageView> getAttachmentImageViews();
+        VknEngineIterator<VkImageView> getAttachmentImageViews();
 
     private:
         // Members
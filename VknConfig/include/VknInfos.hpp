@@ -51,6 +51,8 @@
 #include <limits>
 #include <algorithm>
 #include <vector>
+#include <unordered_map>
+#include <array>
 
 #include <vulkan/vulkan.h>
 #include "VknEngine.hpp"
@@ -71,6 +73,17 @@ namespace vkn
         PRESERVE_ATTACHMENT
     };
 
+    // The state subsets of VK_EXT_graphics_pipeline_library, in VkGraphicsPipelineLibraryFlagBitsEXT order
+    enum VknPipelinePart : uint_fast32_t
+    {
+        VERTEX_INPUT_PART = 0,
+        PRE_RASTERIZATION_PART = 1,
+        FRAGMENT_SHADER_PART = 2,
+        FRAGMENT_OUTPUT_PART = 3,
+        NUM_PIPELINE_PARTS
+    };
+    using VknPipelinePartHashes = std::array<VknHash, NUM_PIPELINE_PARTS>;
+
     class VknInfos
     {
     public:
@@ -100,12 +113,12 @@ namespace vkn
         {
             if (!(this->checkfile(DEVICE_QUEUE_CREATE_INFO)))
                 throw std::runtime_error("DeviceQueueCreateInfo not filed before get.");
-            return &m_queueCreateInfos[deviceIdx](queueFamilyIdx);
+            return filed(m_queueCreateInfos.tryGet(deviceIdx, queueFamilyIdx), "DeviceQueueCreateInfo");
         };
 
         VkRenderPassCreateInfo *getRenderpassCreateInfo(VknIdxs &relIdxs)
         {
-            return &m_renderpassCreateInfos[relIdxs.get<VkDevice>()](relIdxs.get<VkRenderPass>());
+            return filed(m_renderpassCreateInfos.tryGet(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>()), "RenderPassCreateInfo");
         }
 
         VkDeviceCreateInfo *getDeviceCreateInfo(uint32_t deviceIdx)
@@ -114,39 +127,40 @@ namespace vkn
                 throw std::runtime_error("DeviceCreateInfo not filed before get.");
             return &m_deviceCreateInfos(deviceIdx);
         };
-        VknSpace<VkGraphicsPipelineCreateInfo> *getPipelineCreateInfos(VknIdxs &relIdxs)
+        VknVector<VkGraphicsPipelineCreateInfo> *getPipelineCreateInfos(VknIdxs &relIdxs)
         {
-            return &m_gfxPipelineCreateInfos[relIdxs.get<VkDevice>()][relIdxs.get<VkRenderPass>()];
+            return filed(m_gfxPipelineCreateInfos.find(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>()), "GraphicsPipelineCreateInfo");
         }
         VknSpace<VkPipelineShaderStageCreateInfo> *getShaderStageCreateInfos(
             uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
         {
-            return &m_shaderStageCreateInfos[deviceIdx][renderpassIdx][subpassIdx];
+            return m_shaderStageCreateInfos.find(deviceIdx, renderpassIdx, subpassIdx);
         }
         VkPipelineVertexInputStateCreateInfo *getVertexInputStateCreateInfos(
             uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
         {
-            return &m_vertexInputStateCreateInfos[deviceIdx][renderpassIdx](subpassIdx);
+            return filed(m_vertexInputStateCreateInfos.tryGet(deviceIdx, renderpassIdx, subpassIdx), "PipelineVertexInputStateCreateInfo");
         }
         VkPipelineInputAssemblyStateCreateInfo *getInputAssemblyStateCreateInfos(
             uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
         {
-            return &m_inputAssemblyStateCreateInfos[deviceIdx][renderpassIdx](subpassIdx);
+            return filed(m_inputAssemblyStateCreateInfos.tryGet(deviceIdx, renderpassIdx, subpassIdx), "PipelineInputAssemblyStateCreateInfo");
         }
         VkPipelineRasterizationStateCreateInfo *getRasterizationStateCreateInfos(
             uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
         {
-            return &m_rasterizationStateCreateInfos[deviceIdx][renderpassIdx](subpassIdx);
+            return filed(m_rasterizationStateCreateInfos.tryGet(deviceIdx, renderpassIdx, subpassIdx), "PipelineRasterizationStateCreateInfo");
         }
         VkPipelineMultisampleStateCreateInfo *getMultisampleStateCreateInfos(
             uint32_t deviceIdx, uint32_t renderpassIdx, uint32_t subpassIdx)
         {
-            return &m_multisampleStateCreateInfos[deviceIdx][renderpassIdx](subpassIdx);
+            return filed(m_multisampleStateCreateInfos.tryGet(deviceIdx, renderpassIdx, subpassIdx), "PipelineMultisampleStateCreateInfo");
         }
         VkPipelineLayoutCreateInfo *getPipelineLayoutCreateInfo(
             VknIdxs &relIdxs)
         {
-            return &m_layoutCreateInfos[relIdxs.get<VkDevice>()][relIdxs.get<VkRenderPass>()](relIdxs.get<VkPipeline>());
+            return filed(m_layoutCreateInfos.tryGet(relIdxs.get<VkDevice>(), relIdxs.get<VkRenderPass>(), relIdxs.get<VkPipeline>()),
+                         "PipelineLayoutCreateInfo");
         }
         VkSwapchainCreateInfoKHR *getSwapchainCreateInfo(VknIdxs &relIdxs);
         uint32_t getNumDeviceQueueFamilies(uint32_t deviceIdx)
@@ -235,10 +249,10 @@ namespace vkn
         VkPipelineLayoutCreateInfo *filePipelineLayoutCreateInfo(
             VknIdxs &relIdxs,
             VknVectorIterator<VkDescriptorSetLayout> setLayouts,
-            VknVector<VkPushConstantRange> pushConstantRanges,
+            VknVector<VkPushConstantRange> &pushConstantRanges, // Pass by reference
             VkPipelineLayoutCreateFlags flags);
         VkPipelineCacheCreateInfo *filePipelineCacheCreateInfo(
-            size_t initialDataSize,
+            VknIdxs &relIdxs, size_t initialDataSize,
             const void *pInitialData,
             VkPipelineCacheCreateFlags flags);
         VkRenderPassCreateInfo *fileRenderpassCreateInfo(
@@ -289,7 +303,7 @@ namespace vkn
             VkPipelineStageFlags dstStageMask,
             VkAccessFlags dstAccessMask);
         VkDescriptorSetLayoutCreateInfo *fileDescriptorSetLayoutCreateInfo(
-            VknVector<VkDescriptorSetLayoutBinding> bindings,
+            VknVector<VkDescriptorSetLayoutBinding> &bindings, // Pass by reference
             VkDescriptorSetLayoutCreateFlags flags);
         VkVertexInputBindingDescription *fileVertexInputBindingDescription(
             VknIdxs &relIdxs,
@@ -308,7 +322,7 @@ namespace vkn
         VkFramebufferCreateInfo *getFramebufferCreateInfo(VknIdxs &relIdxs);
 
         VkFramebufferCreateInfo *fileFramebufferCreateInfo(VknIdxs &relIdxs, VkRenderPass *renderpass,
-                                                           VknVectorIterator<VkImageView> attachments, uint32_t width,
+                                                           VknEngineIterator<VkImageView> attachments, uint32_t width,
                                                            uint32_t height, uint32_t numLayers, VkFramebufferCreateFlags &flags);
         VkImageViewCreateInfo *fileImageViewCreateInfo(VknIdxs &relIdxs, VkImage &image,
                                                        VkImageViewType &viewType,
@@ -324,7 +338,7 @@ namespace vkn
         void addInstanceExtension(std::string name);
         void addLayer(std::string name);
         void addDeviceExtension(std::string name, VknIdxs relIdxs);
-        void storeName(std::string &name, std::list<std::string> &store, VknVector<const char *> &pointers);
+        void storeName(std::string &name, std::pmr::list<std::pmr::string> &store, VknVector<const char *> &pointers);
 
         VkDebugUtilsMessengerCreateInfoEXT &setDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT createInfo)
         {
@@ -336,64 +350,101 @@ namespace vkn
         void removeImageCreateInfo(VknIdxs relIdxs);
         void removePipelineCreateInfo(VknIdxs relIdxs);
         void removeViewportStateCreateInfo(VknIdxs relIdxs);
+        // Between demolishing and recreating framebuffers. Rewinds their arena if every framebuffer, attachment
+        // image and image view info has been removed, so repeated resizes reuse the same memory.
+        bool resetRebuildInfos();
         VknFeatures *getDeviceFeaturesObject();
         void fileDeviceFeaturesInfo();
 
+        // Content hashes for pipeline deduplication. Each handle is hashed from its create info when it is
+        // created, so a pipeline hash covers what its modules, layout and render pass were made from.
+        void hashShaderModule(VkShaderModule module, VkShaderModuleCreateInfo &info);
+        void hashDescriptorSetLayout(VkDescriptorSetLayout layout, VkDescriptorSetLayoutCreateInfo &info);
+        void hashPipelineLayout(VkPipelineLayout layout, VkPipelineLayoutCreateInfo &info);
+        void hashRenderpass(VkRenderPass renderpass, VkRenderPassCreateInfo &info);
+        // 0 if the pipeline can't be shared: extension chains, derivatives or handles that were never hashed
+        VknHash hashGfxPipeline(VkGraphicsPipelineCreateInfo &info);
+        // Only the state one library part is built from, 0 under the same conditions
+        VknHash hashGfxPipelinePart(VkGraphicsPipelineCreateInfo &info, VknPipelinePart part);
+
     private:
+        // Getters look infos up without filing empty ones, a miss means the info was never filed
+        template <typename InfoType>
+        static InfoType *filed(InfoType *info, const char *infoName)
+        {
+            if (!info)
+                throw std::runtime_error(std::string{infoName} + " not filed before get.");
+            return info;
+        }
+
+        // Declared ahead of the trees so they outlive them. Infos are filed once and removed rarely, so
+        // linear allocation wastes little and keeps configuration nearly free of allocator calls.
+        VknArena m_arena{};        // Everything filed for the life of the config
+        VknArena m_rebuildArena{}; // Framebuffer, attachment image and image view infos, see resetRebuildInfos()
+        // Pipeline and viewport state infos are removed and filed again on every recreatePipelines(). A pool
+        // reuses what they free, so recreating doesn't grow the footprint the way m_arena would.
+        std::pmr::unsynchronized_pool_resource m_refilePool{};
+
         std::string m_appName{};
         std::string m_engineName{};
-        std::list<std::string> m_instanceExtensions_Store{};
-        VknVector<const char *> m_instanceExtensions_NamePointers{};
-        std::list<std::string> m_deviceExtensions_Store{1};
-        VknSpace<const char *> m_deviceExtensions_NamePointers{1u};
-        std::list<std::string> m_layers_Store{};
-        VknVector<const char *> m_layers_NamePointers{};
+        std::pmr::list<std::pmr::string> m_instanceExtensions_Store{&m_arena};
+        VknVector<const char *> m_instanceExtensions_NamePointers{&m_arena};
+        std::pmr::list<std::pmr::string> m_deviceExtensions_Store{1, &m_arena};
+        VknSpace<const char *> m_deviceExtensions_NamePointers{1u, 0u, true, &m_arena};
+        std::pmr::list<std::pmr::string> m_layers_Store{&m_arena};
+        VknVector<const char *> m_layers_NamePointers{&m_arena};
         VknFeatures m_enabledFeatures{};
         VkPhysicalDeviceFeatures2 m_featuresInfo{};
-        VknSpace<float> m_queuePriorities{2u};    // Device>QueueFamily>Queue#QueuePriority
-        VknVector<uint32_t> m_numQueueFamilies{}; // Device#NumQueueFamilies
+        VknSpace<float> m_queuePriorities{2u, 0u, true, &m_arena}; // Device>QueueFamily>Queue#QueuePriority
+        VknVector<uint32_t> m_numQueueFamilies{&m_arena};          // Device#NumQueueFamilies
         VkDebugUtilsMessengerCreateInfoEXT m_debugMessengerCreateInfo{};
 
         // Info's
         VkApplicationInfo m_appInfo{};
         VkInstanceCreateInfo m_instanceCreateInfo{};
-        VknSpace<VkDeviceQueueCreateInfo> m_queueCreateInfos{1u}; // Device>QueueFamily#Infos
-        VknVector<VkDeviceCreateInfo> m_deviceCreateInfos{};      // Device#Info
-
-        VknSpace<VkPipelineLayoutCreateInfo> m_layoutCreateInfos{2u};                         // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineCacheCreateInfo> m_cacheCreateInfos{2u};                           // Device>Renderpass>Subpass#info
-        VknSpace<VkShaderModuleCreateInfo> m_shaderModuleCreateInfos{3u};                     // Device>Renderpass>Subpass>Shader#info
-        VknSpace<VkPipelineShaderStageCreateInfo> m_shaderStageCreateInfos{3u};               // Device>Renderpass>Subpass>Shader#info
-        VknSpace<VkPipelineVertexInputStateCreateInfo> m_vertexInputStateCreateInfos{2u};     // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineInputAssemblyStateCreateInfo> m_inputAssemblyStateCreateInfos{2u}; // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineTessellationStateCreateInfo> m_tessellationStateCreateInfos{2u};   // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineViewportStateCreateInfo> m_viewportStateCreateInfos{2u};           // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineRasterizationStateCreateInfo> m_rasterizationStateCreateInfos{2u}; // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineMultisampleStateCreateInfo> m_multisampleStateCreateInfos{2u};     // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineDepthStencilStateCreateInfo> m_depthStencilStateCreateInfos{2u};   // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineColorBlendStateCreateInfo> m_colorBlendStateCreateInfos{2u};       // Device>Renderpass>Subpass#info
-        VknSpace<VkPipelineDynamicStateCreateInfo> m_dynamicStateCreateInfos{2u};             // Device>Renderpass>Subpass#info
-        VknSpace<VkGraphicsPipelineCreateInfo> m_gfxPipelineCreateInfos{2u};                  // Device>Renderpass>Subpass#info
-        VknSpace<VkSwapchainCreateInfoKHR> m_swapchainCreateInfos{1u};                        // Device>Swapchain#info
-
-        VknSpace<VkRenderPassCreateInfo> m_renderpassCreateInfos{1u};                   // Device>Renderpass#info (multi, some per device)
-        VknSpace<VkAttachmentDescription> m_attachmentDescriptions{2u};                 // Device>Renderpass>Attachment#description
-        VknSpace<VkAttachmentReference> m_attachmentReferences{4u};                     // Device>Renderpass>Subpass>AttachmentType>Attachment#ref
-        VknSpace<uint32_t> m_preserveAttachments{3u};                                   // Device>Renderpass>Subpass>Attachment#ref
-        VknSpace<VkSubpassDescription> m_subpassDescriptions{2u};                       // Device>Renderpass>Subpass#info
-        VknSpace<VkSubpassDependency> m_subpassDependencies{2u};                        // Device>Renderpass>Dependency#description
-        VknSpace<VkDescriptorSetLayoutCreateInfo> m_descriptorSetLayoutCreateInfos{3u}; // Device>Renderpass>PipelineLayout>DescriptorSetlayout#info
-
-        VknSpace<VkVertexInputBindingDescription> m_vertexInputBindings{3u};     // Device>Renderpass>Subpass>InputBiding#Infos
-        VknSpace<VkVertexInputAttributeDescription> m_vertexInputAttributes{3u}; // Device>Renderpass>Subpass>InputAttribute#Infos
-
-        VknSpace<VkFramebufferCreateInfo> m_framebufferCreateInfos{2u}; // Device>Renderpass>Framebuffer#CreateInfo
-        VknVector<VkImageViewCreateInfo> m_imageViewCreateInfos{};      // >ImageViews
-        VknVector<VkImageCreateInfo> m_imageCreateInfos{};              //>Image
-
-        VknSpace<VkMemoryAllocateInfo> m_deviceMemoryAllocateInfos{1u}; // Device>DeviceMemory#AllocateInfo
-        VknSpace<VkBufferCreateInfo> m_bufferCreateInfos{1u};           // Device>Buffer#CreateInfo
-        VknSpace<VmaAllocation> m_vmaAllocationInfos{1u};               // Device>VmaAllocation#Info
+        VknSpace<VkDeviceQueueCreateInfo> m_queueCreateInfos{1u, 0u, true, &m_arena}; // Device>QueueFamily#Infos
+        VknVector<VkDeviceCreateInfo> m_deviceCreateInfos{&m_arena};                  // Device#Info
+
+        VknFlatSpace<VkPipelineLayoutCreateInfo> m_layoutCreateInfos{2u, &m_arena};                         // Device>Renderpass>Subpass#info
+        VknVector<VkPipelineCacheCreateInfo> m_cacheCreateInfos{&m_arena};                                   // Device#info
+        VknSpace<VkShaderModuleCreateInfo> m_shaderModuleCreateInfos{3u, 0u, true, &m_arena};               // Device>Renderpass>Subpass>Shader#info
+        VknSpace<VkPipelineShaderStageCreateInfo> m_shaderStageCreateInfos{3u, 0u, true, &m_arena};         // Device>Renderpass>Subpass>Shader#info
+        VknFlatSpace<VkPipelineVertexInputStateCreateInfo> m_vertexInputStateCreateInfos{2u, &m_arena};     // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineInputAssemblyStateCreateInfo> m_inputAssemblyStateCreateInfos{2u, &m_arena}; // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineTessellationStateCreateInfo> m_tessellationStateCreateInfos{2u, &m_arena};   // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineViewportStateCreateInfo> m_viewportStateCreateInfos{2u, &m_refilePool};      // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineRasterizationStateCreateInfo> m_rasterizationStateCreateInfos{2u, &m_arena}; // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineMultisampleStateCreateInfo> m_multisampleStateCreateInfos{2u, &m_arena};     // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineDepthStencilStateCreateInfo> m_depthStencilStateCreateInfos{2u, &m_arena};   // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineColorBlendStateCreateInfo> m_colorBlendStateCreateInfos{2u, &m_arena};       // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkPipelineDynamicStateCreateInfo> m_dynamicStateCreateInfos{2u, &m_arena};             // Device>Renderpass>Subpass#info
+        VknFlatSpace<VkGraphicsPipelineCreateInfo> m_gfxPipelineCreateInfos{2u, &m_refilePool};             // Device>Renderpass>Subpass#info
+        VknSpace<VkSwapchainCreateInfoKHR> m_swapchainCreateInfos{1u, 0u, true, &m_arena};                  // Device>Swapchain#info
+
+        VknSpace<VkRenderPassCreateInfo> m_renderpassCreateInfos{1u, 0u, true, &m_arena};                   // Device>Renderpass#info (multi, some per device)
+        VknSpace<VkAttachmentDescription> m_attachmentDescriptions{2u, 0u, true, &m_arena};                 // Device>Renderpass>Attachment#description
+        VknSpace<VkAttachmentReference> m_attachmentReferences{4u, 0u, true, &m_arena};                     // Device>Renderpass>Subpass>AttachmentType>Attachment#ref
+        VknSpace<uint32_t> m_preserveAttachments{3u, 0u, true, &m_arena};                                   // Device>Renderpass>Subpass>Attachment#ref
+        VknSpace<VkSubpassDescription> m_subpassDescriptions{2u, 0u, true, &m_arena};                       // Device>Renderpass>Subpass#info
+        VknSpace<VkSubpassDependency> m_subpassDependencies{2u, 0u, true, &m_arena};                        // Device>Renderpass>Dependency#description
+        VknSpace<VkDescriptorSetLayoutCreateInfo> m_descriptorSetLayoutCreateInfos{3u, 0u, true, &m_arena}; // Device>Renderpass>PipelineLayout>DescriptorSetlayout#info
+
+        VknSpace<VkVertexInputBindingDescription> m_vertexInputBindings{3u, 0u, true, &m_arena};     // Device>Renderpass>Subpass>InputBiding#Infos
+        VknSpace<VkVertexInputAttributeDescription> m_vertexInputAttributes{3u, 0u, true, &m_arena}; // Device>Renderpass>Subpass>InputAttribute#Infos
+
+        VknFlatSpace<VkFramebufferCreateInfo> m_framebufferCreateInfos{2u, &m_rebuildArena};                 // Device>Renderpass>Framebuffer#CreateInfo
+        VknVector<VkImageViewCreateInfo, VknEngineIdx<VkImageView>> m_imageViewCreateInfos{&m_rebuildArena}; // >ImageViews
+        VknVector<VkImageCreateInfo, VknEngineIdx<VkImage>> m_imageCreateInfos{&m_rebuildArena};             //>Image
+
+        VknSpace<VkMemoryAllocateInfo> m_deviceMemoryAllocateInfos{1u, 0u, true, &m_arena};               // Device>DeviceMemory#AllocateInfo
+        VknSpace<VkBufferCreateInfo, VknEngineIdx<VkBuffer>> m_bufferCreateInfos{1u, 0u, true, &m_arena}; // Device>Buffer#CreateInfo
+        VknSpace<VmaAllocation> m_vmaAllocationInfos{1u, 0u, true, &m_arena};                             // Device>VmaAllocation#Info
+
+        // Content hashes by handle, see hashGfxPipeline()
+        std::unordered_map<VkShaderModule, VknHash> m_shaderModuleHashes{};
+        std::unordered_map<VkDescriptorSetLayout, VknHash> m_setLayoutHashes{};
+        std::unordered_map<VkPipelineLayout, VknHash> m_pipelineLayoutHashes{};
+        std::unordered_map<VkRenderPass, VknHash> m_renderpassHashes{};
 
         // Required file checklist
         bool m_filedAppInfo{false};
@@ -58,6 +58,9 @@ namespace vkn
         void setDetails(VkPrimitiveTopology topology, VkBool32 primitiveRestartEnable);
         void _fileInputAssemblyStateCreateInfo();
 
+        VkPrimitiveTopology getTopology() { return m_topology; }
+        VkBool32 getPrimitiveRestartEnable() { return m_primitiveRestartEnable; }
+
     private:
         // Params
         VkPrimitiveTopology m_topology{VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
@@ -15,6 +15,15 @@ namespace vkn
         void exit();
 
     protected:
+        // Handle type and relative indices for VknResult, empty unless tracing
+        template <typename VkObjectType>
+        std::string traceArgs()
+        {
+            if (!VknTrace::isEnabled())
+                return "";
+            return "{\"type\":\"" + typeToStr<VkObjectType>() + "\",\"relIdxs\":" + m_relIdxs.toJson() + "}";
+        }
+
         // Engine
         static VknEngine *s_engine;
         VknIdxs m_relIdxs;
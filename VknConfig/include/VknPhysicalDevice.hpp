@@ -47,11 +47,14 @@
 
 #include <list>
 #include <iostream>
+#include <vector>
+#include <cstring>
 
 #include <vulkan/vulkan.h>
 #include "VknQueueFamily.hpp"
 #include "VknData.hpp"
 #include "VknObject.hpp"
+#include "VknDynamicState.hpp"
 
 namespace vkn
 {
@@ -82,6 +85,9 @@ namespace vkn
         VknQueueFamily &getQueue(int idx);
         VknIdxs getPhysicalDeviceAbsIdxs() { return m_absIdxs; }
         VkPhysicalDeviceType getGPUType();
+        bool supportsExtension(const char *name);
+        bool supportsGraphicsPipelineLibrary(); // The extensions and the feature
+        VknExtendedDynamicState getExtendedDynamicStateSupport(); // Highest level with its extensions and features
 
     private:
         // Members
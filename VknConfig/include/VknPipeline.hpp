@@ -53,6 +53,7 @@
 #include <list>
 #include <filesystem>
 #include <iterator>
+#include <atomic>
 
 #include "VknObject.hpp"
 #include "VknData.hpp"
@@ -86,9 +87,12 @@ namespace vkn
         void setBasePipelineIndex(int32_t basePipelineIndex) { m_basePipelineIndex = basePipelineIndex; }
         void setCreateFlags(VkPipelineCreateFlags createFlags) { m_createFlags = createFlags; }
         void setNumHardCodedVertices(uint_fast32_t numVertices) { m_numHardcodedVertices = numVertices; }
+        // Bound in this pipeline's place until it's ready. Must be compatible with the same renderpass and subpass.
+        void setFallback(VknPipeline *fallback) { m_fallback = fallback; }
 
         // Create
         VkGraphicsPipelineCreateInfo *_filePipelineCreateInfo();
+        void _setReady(bool ready) { m_ready.store(ready, std::memory_order_release); }
 
         // Get
         VknShaderStage *getShaderStage(uint32_t shaderIdx);
@@ -105,6 +109,8 @@ namespace vkn
         VknIdxs &getRelIdxs() { return m_relIdxs; }
         VknIdxs &getAbsIdxs() { return m_absIdxs; }
         uint_fast32_t getNumHardCodedVertices() { return m_numHardcodedVertices; }
+        bool isReady() { return m_ready.load(std::memory_order_acquire); } // getVkPipeline() is valid once true
+        VknPipeline *getFallback() { return m_fallback; }
 
     private:
         //  Members
@@ -123,9 +129,11 @@ namespace vkn
         VkPipeline m_basePipelineHandle{VK_NULL_HANDLE};
         int32_t m_basePipelineIndex{-1};
         VkPipelineCreateFlags m_createFlags{0};
+        VknPipeline *m_fallback{nullptr};
 
         // State
         bool m_createdPipeline{false};
+        std::atomic<bool> m_ready{false}; // Set from the build thread of an async createPipelinesAsync()
         uint_fast32_t m_numHardcodedVertices{0};
         VknInstanceLock<VknPipeline> m_instanceLock;
     };
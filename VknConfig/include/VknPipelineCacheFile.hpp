@@ -0,0 +1,37 @@
+/**
+ * @file VknPipelineCacheFile.hpp
+ * @brief Reads and writes VkPipelineCache blobs on disk.
+ *
+ * VknPipelineCacheFile is a free/top-level class within the VknConfig project.
+ * VknDevice seeds its pipeline cache from a blob at creation and VknEngine
+ * writes the blob back before destroying the cache. Blobs are keyed by the
+ * device and driver they were written by, and checked against them on load.
+ * VknPipelineCacheFile does not depend on any other Vkn classes.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <vulkan/vulkan.h>
+
+namespace vkn
+{
+    class VknPipelineCacheFile
+    {
+    public:
+        VknPipelineCacheFile() = delete;
+
+        /** @brief A file in directory named for the vendor, device, driver version and pipeline cache UUID. */
+        static std::filesystem::path keyedPath(const std::filesystem::path &directory,
+                                               const VkPhysicalDeviceProperties &properties);
+        /** @brief Empty if the file is missing, truncated, or was written by another device or driver. */
+        static std::vector<char> load(const std::filesystem::path &path, const VkPhysicalDeviceProperties &properties);
+        /** @brief Writes a temporary file and renames it over path, so readers never see a partial blob.
+         *  @return False if nothing was written. */
+        static bool save(VkDevice device, VkPipelineCache cache, const std::filesystem::path &path);
+    };
+}
@@ -68,6 +68,12 @@ namespace vkn
 
         void _fileRasterizationStateCreateInfo();
 
+        // Set at record time instead when the dynamic state has them, see VknExtendedDynamicState
+        VkPolygonMode getPolygonMode() { return m_polygonMode; }
+        VkCullModeFlags getCullMode() { return m_cullMode; }
+        VkFrontFace getFrontFace() { return m_frontFace; }
+        VkBool32 getDepthBiasEnable() { return m_depthBiasEnable; }
+
     private:
         // Members
         VkPolygonMode m_polygonMode{VK_POLYGON_MODE_FILL};
@@ -44,6 +44,11 @@
 
 #pragma once
 
+#include <thread>
+#include <span>
+#include <exception>
+#include <future>
+
 #include "VknObject.hpp"
 #include "VknPipeline.hpp"
 #include "VknFramebuffer.hpp"
@@ -90,10 +95,24 @@ namespace vkn
                                   VkAccessFlags srcAccessMask = 0,
                                   VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                                   VkAccessFlags dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        // Threads createPipelines() may compile on, 0 for one per core
+        void setMaxPipelineThreads(uint32_t maxThreads) { m_maxPipelineThreads = maxThreads; }
+        // Only on a device with VknDevice::enablePipelineLibrary(). New pipelines are fast-linked from library
+        // parts cached by part hash, so a new combination of known parts doesn't compile any shaders.
+        void setUsePipelineLibrary(bool use) { m_usePipelineLibrary = use; }
+        // At most what VknDevice::enableExtendedDynamicState() returned. The states of level become dynamic
+        // in every pipeline and are set by VknCycle, so pipelines differing only in them are shared.
+        void setExtendedDynamicState(VknExtendedDynamicState level) { m_extendedDynamicState = level; }
 
         // Create
         void createRenderpass();
         void createPipelines();
+        // Returns once every pipeline's infos are filed and compiles on a background thread. Each VknPipeline
+        // reports ready as its handle is published. Other pipeline infos must not be filed, and the filed ones
+        // (viewport states included) must not change, until it finishes.
+        void createPipelinesAsync();
+        void waitForPipelines();   // Rethrows if the async build failed
+        void checkPipelineBuild(); // Doesn't wait, but rethrows if the async build already failed
         void createFramebuffers(VknSwapchain &swapchain);
         void demolishFramebuffers();
         void recreatePipelines(VknSwapchain &swapchain, uint32_t viewportIdx, uint32_t scissorIdx);
@@ -122,6 +141,9 @@ namespace vkn
         uint32_t m_numSubpassDeps{0};
         uint32_t m_numAttachments{0};
         uint32_t m_numSubpasses{0};
+        uint32_t m_maxPipelineThreads{0};
+        bool m_usePipelineLibrary{false};
+        VknExtendedDynamicState m_extendedDynamicState{EXTENDED_DYNAMIC_STATE_NONE};
         size_t m_pipelineStartAbsIdx{0};
         bool m_recreatingPipelines{false};
         uint32_t m_framebufferStartPos{0};
@@ -129,7 +151,16 @@ namespace vkn
         bool m_addedFramebuffers{false};
         bool m_demolishedVknFramebuffers{true};
         VknInstanceLock<VknRenderpass> m_instanceLock;
+        std::shared_future<void> m_pipelineBuild{};
 
         VknPipeline *addPipeline(uint32_t subpassIdx);
+        void buildPipelines(bool async);
+        void compilePipelines(VkDevice device, std::span<const VkGraphicsPipelineCreateInfo> infos,
+                              std::span<VkPipeline> pipelines, bool splittable,
+                              std::span<const VknPipelinePartHashes> parts); // Empty parts for monolithic
+        VkPipeline linkPipeline(VkDevice device, VkPipelineCache cache, const VkGraphicsPipelineCreateInfo &info,
+                                const VknPipelinePartHashes &parts);
+        VkPipeline compilePipelinePart(VkDevice device, VkPipelineCache cache,
+                                       const VkGraphicsPipelineCreateInfo &info, VknPipelinePart part);
     };
 }
\ No newline at end of file
@@ -47,11 +47,13 @@
 #include <string>
 #include <format>
 #include <queue>
+#include <mutex>
 #include <string>
 #include <stdexcept> // Ensure this is included for std::runtime_error
 #include <format>    // Ensure this is included for std::format
 
 #include <vulkan/vulkan.h>
+#include "VknTrace.hpp"
 
 namespace vkn
 {
@@ -67,6 +69,7 @@ namespace vkn
     private:
         std::queue<T> m_data{};
         uint32_t m_capacity{1000}; /**< The maximum number of results to store. */
+        std::mutex m_lock{};       /**< Results are stored from pipeline compile workers too. */
 
         /** @brief Manages the size of the archive, removing old results if necessary. */
         void manage()
@@ -83,6 +86,7 @@ namespace vkn
         {
             if (!res.isErrorStateEvaluated())
                 throw std::runtime_error("Target function not called, no result to store.");
+            std::scoped_lock lock{m_lock};
             m_data.push(res);
             this->manage();
         }
@@ -93,7 +97,10 @@ namespace vkn
     public:
         // Overloads
         VknResult() = delete;
-        VknResult(std::string opDesc);
+        /** @brief Assign the VkResult to evaluate it. With traceArgs, and while tracing, the time until then
+         * is recorded. Long-lived results reassigned every frame pass none.
+         * @param traceArgs JSON object describing the handle, only built when VknTrace::isEnabled(). */
+        VknResult(std::string opDesc, std::string traceArgs = "");
         VknResult(VkResult result, std::string opDesc);
         void operator=(VkResult result) { this->evaluate(result); }
 
@@ -113,9 +120,12 @@ namespace vkn
         VkResult m_result{};
         std::string m_opDesc{""};               /**< A description of the operation that produced this result. */
         static VknArchive<VknResult> s_archive; /**< A static archive to store all VknResult objects. */
+        std::string m_traceArgs{""};
+        uint_fast64_t m_traceBegin{0};
 
         // State
         bool m_evaluatedErrorState{false}; /**< True if the result has been evaluated. */
+        bool m_traced{false};              /**< True if construction happened while tracing. */
 
         /** @brief Evaluates the given VkResult and updates the internal state.
          * @param result The VkResult to evaluate. */
@@ -121,5 +121,6 @@ namespace vkn
 
         void setImageCount();
         void setImageDimensions();
+        void resetCreationState();
     };
 }
\ No newline at end of file
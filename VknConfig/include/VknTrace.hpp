@@ -0,0 +1,78 @@
+/**
+ * @file VknTrace.hpp
+ * @brief Opt-in lifecycle tracing written as Chrome trace-event JSON.
+ *
+ * VknTrace is a free/top-level class within the VknConfig project. VknResult
+ * records the Vulkan creation calls it evaluates and VknEngine records its
+ * demolish passes. Load the written file in chrome://tracing or Perfetto.
+ * VknTrace does not depend on any other Vkn classes.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+namespace vkn
+{
+    class VknTrace
+    {
+    public:
+        VknTrace() = delete;
+
+        /** @brief Starts recording. Events are buffered until disable() writes them to path. */
+        static void enable(std::string path);
+        /** @brief Stops recording and writes the buffered events. Does nothing if not enabled.
+         *  @return False if the trace file couldn't be written. I/O errors are never thrown. */
+        static bool disable();
+        static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        /** @brief Microseconds since tracing was enabled. */
+        static uint_fast64_t now();
+        /** @param args A JSON object, or empty for none. */
+        static void record(std::string name, std::string category, uint_fast64_t begin, uint_fast64_t end,
+                           std::string args);
+
+    private:
+        struct VknTraceEvent
+        {
+            std::string name;
+            std::string category;
+            uint_fast64_t begin;
+            uint_fast64_t end;
+            uint_fast32_t thread;
+            std::string args;
+        };
+
+        static std::atomic<bool> s_enabled;
+        static std::mutex s_lock;
+        static std::vector<VknTraceEvent> s_events;
+        static std::string s_path;
+        static std::atomic<std::chrono::steady_clock::rep> s_epoch; // Read by now() on any thread
+
+        static std::string escape(const std::string &str);
+    };
+
+    // Records the time between construction and destruction, if tracing was enabled at construction
+    class VknTraceScope
+    {
+    public:
+        VknTraceScope(std::string name, std::string category, std::string args = "");
+        ~VknTraceScope();
+
+        VknTraceScope(const VknTraceScope &) = delete;
+        VknTraceScope &operator=(const VknTraceScope &) = delete;
+
+    private:
+        std::string m_name;
+        std::string m_category;
+        std::string m_args;
+        uint_fast64_t m_begin{0};
+        bool m_active{false};
+    };
+}
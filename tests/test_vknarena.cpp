@@ -0,0 +1,144 @@
+// tests/test_vknarena.cpp
+#include "gtest/gtest.h"
+#include "../VknConfig/include/VknData.hpp" // Adjust path as necessary
+
+// Counts what the arena asks of its upstream
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int allocations{0};
+    int deallocations{0};
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+class VknArenaTest : public ::testing::Test
+{
+protected:
+    CountingResource upstream{};
+
+    void SetUp() override
+    {
+        // Common setup if needed
+    }
+
+    void TearDown() override
+    {
+        // Common teardown if needed
+    }
+};
+
+TEST_F(VknArenaTest, Allocate_BumpsThroughOneBlock)
+{
+    vkn::VknArena arena{1024u, &upstream};
+    ASSERT_EQ(arena.getNumBlocks(), 0);
+    char *first = static_cast<char *>(arena.allocate(10u, 1u));
+    char *second = static_cast<char *>(arena.allocate(10u, 1u));
+    ASSERT_EQ(second, first + 10);
+    ASSERT_EQ(upstream.allocations, 1);
+    ASSERT_EQ(arena.getBytesReserved(), 1024u);
+}
+
+TEST_F(VknArenaTest, Allocate_RespectsAlignment)
+{
+    vkn::VknArena arena{1024u, &upstream};
+    (void)arena.allocate(1u, 1u);
+    void *aligned = arena.allocate(8u, 64u);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64u, 0u);
+}
+
+TEST_F(VknArenaTest, Allocate_OversizedGetsItsOwnBlock)
+{
+    vkn::VknArena arena{64u, &upstream};
+    (void)arena.allocate(4096u, 8u);
+    ASSERT_EQ(arena.getNumBlocks(), 1);
+    ASSERT_GE(arena.getBytesReserved(), 4096u);
+}
+
+TEST_F(VknArenaTest, Deallocate_OnlyReclaimsMostRecent)
+{
+    vkn::VknArena arena{1024u, &upstream};
+    void *first = arena.allocate(16u, 8u);
+    void *second = arena.allocate(16u, 8u);
+    arena.deallocate(first, 16u, 8u); // Not the top, ignored
+    ASSERT_NE(arena.allocate(16u, 8u), first);
+    void *top = arena.allocate(16u, 8u);
+    arena.deallocate(top, 16u, 8u);
+    ASSERT_EQ(arena.allocate(16u, 8u), top);
+    (void)second;
+}
+
+TEST_F(VknArenaTest, Rewind_ReusesBlocksWithoutUpstreamCalls)
+{
+    vkn::VknArena arena{256u, &upstream};
+    (void)arena.allocate(32u, 8u);
+    vkn::VknArena::Marker marker = arena.mark();
+    void *afterMark = nullptr;
+    for (int round = 0; round < 5; ++round)
+    {
+        {
+            vkn::VknVector<int> vec{&arena};
+            for (int i = 0; i < 200; ++i)
+                vec.appendOne(i);
+            ASSERT_EQ(vec(199), 199);
+        }
+        int upstreamCalls = upstream.allocations;
+        arena.rewind(marker);
+        void *next = arena.allocate(4u, 4u);
+        if (round == 0)
+            afterMark = next;
+        ASSERT_EQ(next, afterMark); // Same memory every round
+        ASSERT_EQ(upstream.allocations, upstreamCalls);
+        arena.rewind(marker);
+    }
+    int blocks = arena.getNumBlocks();
+    ASSERT_EQ(upstream.allocations, blocks); // Only the first round reached upstream
+}
+
+TEST_F(VknArenaTest, Rewind_ForwardThrows)
+{
+    vkn::VknArena arena{256u, &upstream};
+    vkn::VknArena::Marker start = arena.mark();
+    (void)arena.allocate(32u, 8u);
+    vkn::VknArena::Marker later = arena.mark();
+    arena.rewind(start);
+    ASSERT_THROW(arena.rewind(later), std::runtime_error);
+}
+
+TEST_F(VknArenaTest, Release_ReturnsEveryBlock)
+{
+    {
+        vkn::VknArena arena{64u, &upstream};
+        for (int i = 0; i < 10; ++i)
+            (void)arena.allocate(48u, 8u);
+        ASSERT_GT(arena.getNumBlocks(), 1);
+        arena.release();
+        ASSERT_EQ(arena.getNumBlocks(), 0);
+        ASSERT_EQ(upstream.deallocations, upstream.allocations);
+        (void)arena.allocate(8u, 8u); // Usable again, the destructor returns this one
+    }
+    ASSERT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST_F(VknArenaTest, Spaces_ShareTheArena)
+{
+    vkn::VknArena arena{4096u, &upstream};
+    vkn::VknSpace<int> space{2u, 0u, true, &arena};
+    vkn::VknFlatSpace<int> flat{2u, &arena};
+    space[1][2].append(3);
+    flat[1][2].append(3);
+    ASSERT_EQ(space[1][2](0), 3);
+    ASSERT_EQ(flat[1][2](0), 3);
+    ASSERT_EQ(upstream.allocations, 1);
+}
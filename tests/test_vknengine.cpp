@@ -0,0 +1,30 @@
+// tests/test_vknengine.cpp
+#include "gtest/gtest.h"
+#include "../VknConfig/include/VknEngine.hpp" // Adjust path as necessary
+
+TEST(VknEngineTest, CompactVector_StalesVacatedPositions)
+{
+    vkn::VknEngine engine{};
+    for (uint32_t i = 0; i < 10u; ++i)
+        engine.push_back<VkPipeline>();
+    vkn::VknIdxs before{};
+    before.add<VkPipeline>(7u, engine.getGeneration<VkPipeline>(7u));
+    for (uint32_t i = 0; i < 5u; ++i)
+        engine.removeObject<VkPipeline>(i);
+    engine.compactVector<VkPipeline>(); // Positions 5 to 9 move to 0 to 4
+    while (engine.getVectorSize<VkPipeline>() <= 7u)
+        engine.push_back<VkPipeline>(); // Reuses position 7
+    ASSERT_FALSE(engine.isCurrent<VkPipeline>(before));
+}
+
+TEST(VknEngineTest, GetObject_ThrowsForStaleIndex)
+{
+    vkn::VknEngine engine{};
+    engine.push_back<VkPipeline>();
+    vkn::VknIdxs before{};
+    before.add<VkPipeline>(0u, engine.getGeneration<VkPipeline>(0u));
+    ASSERT_NO_THROW(engine.getObject<VkPipeline>(before));
+    engine.removeObject<VkPipeline>(0u);
+    engine.push_back<VkPipeline>(); // Reuses position 0
+    ASSERT_THROW(engine.getObject<VkPipeline>(before), std::runtime_error);
+}
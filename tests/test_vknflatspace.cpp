@@ -0,0 +1,91 @@
+// tests/test_vknflatspace.cpp
+#include "gtest/gtest.h"
+#include "../VknConfig/include/VknData.hpp" // Adjust path as necessary
+
+class VknFlatSpaceTest : public ::testing::Test
+{
+protected:
+    vkn::VknFlatSpace<int> space_int{2u}; // Device>Renderpass#data, like most VknInfos trees
+
+    void SetUp() override
+    {
+        // Common setup if needed
+    }
+
+    void TearDown() override
+    {
+        // Common teardown if needed
+    }
+};
+
+TEST_F(VknFlatSpaceTest, Construction_InvalidDepth_Throws)
+{
+    ASSERT_THROW(vkn::VknFlatSpace<int>{0u}, std::runtime_error);
+    ASSERT_THROW(vkn::VknFlatSpace<int>{9u}, std::runtime_error);
+    ASSERT_EQ(space_int.getMaxDepth(), 2);
+    ASSERT_EQ(space_int.getNumLeaves(), 0);
+}
+
+TEST_F(VknFlatSpaceTest, InsertAndAccess_SameSurfaceAsVknSpace)
+{
+    space_int[1][3].insert(13, 2);
+    int *appended = &space_int[1][3].append(14);
+    space_int[0][0].append(0);
+    ASSERT_EQ(space_int[1][3](2), 13);
+    ASSERT_EQ(&space_int[1][3](3), appended); // Other leafs don't move this one's elements
+    ASSERT_EQ(space_int[1][3].getDataSize(), 2);
+    ASSERT_EQ(space_int[0][0](0), 0);
+    ASSERT_EQ(space_int.getNumLeaves(), 2);
+    ASSERT_EQ(space_int[1][3].getDepth(), 2);
+}
+
+TEST_F(VknFlatSpaceTest, DepthRules_Throw)
+{
+    ASSERT_THROW(space_int[0].append(1), std::runtime_error);  // Not a leaf
+    ASSERT_THROW(space_int[0][0][0], std::runtime_error);      // Too deep
+    ASSERT_THROW(space_int[256], std::runtime_error);          // Doesn't fit the key
+    ASSERT_THROW(space_int[2][2](0), std::runtime_error);      // No data
+}
+
+TEST_F(VknFlatSpaceTest, ManyLeaves_ElementsStayPut)
+{
+    int *first = &space_int[40][0].append(-1);
+    for (uint32_t i = 0; i < 32; ++i)
+        for (uint32_t j = 0; j < 32; ++j)
+            space_int[i][j].insert(static_cast<int>(i * 100 + j), j);
+    ASSERT_EQ(space_int.getNumLeaves(), 1025);
+    ASSERT_EQ(&space_int[40][0](0), first);
+    for (uint32_t i = 0; i < 32; ++i)
+        for (uint32_t j = 0; j < 32; ++j)
+            ASSERT_EQ(space_int[i][j](j), static_cast<int>(i * 100 + j));
+    space_int[31][31].getDataVector().remove(31);
+    ASSERT_FALSE(space_int[31][31].getDataVector().exists(31));
+}
+
+TEST_F(VknFlatSpaceTest, FindAndTryGet_DoNotAddLeaves)
+{
+    ASSERT_EQ(space_int.find(0, 1), nullptr);
+    ASSERT_EQ(space_int.tryGet(0, 1, 0), nullptr);
+    ASSERT_EQ(space_int.getNumLeaves(), 0);
+
+    space_int[0][1].insert(7, 4);
+    ASSERT_EQ(space_int.find(0, 1), &space_int[0][1].getDataVector());
+    ASSERT_EQ(*space_int.tryGet(0, 1, 4), 7);
+    ASSERT_EQ(space_int.tryGet(0, 1, 5), nullptr);
+    ASSERT_EQ(space_int.tryGet(1, 0, 4), nullptr);
+    ASSERT_EQ(space_int.find(300, 0), nullptr);
+    ASSERT_THROW(space_int.find(0), std::runtime_error); // Not a leaf
+    ASSERT_EQ(space_int.getNumLeaves(), 1);
+}
+
+TEST_F(VknFlatSpaceTest, IsEmpty_TrueOnceEveryLeafIsEmptied)
+{
+    ASSERT_TRUE(space_int.isEmpty());
+    space_int[1][3].append(13);
+    space_int[0][0].append(0);
+    ASSERT_FALSE(space_int.isEmpty());
+    space_int[1][3].getDataVector().remove(0);
+    ASSERT_FALSE(space_int.isEmpty());
+    space_int[0][0].getDataVector().remove(0);
+    ASSERT_TRUE(space_int.isEmpty()); // Leaves remain, but hold nothing
+}
@@ -0,0 +1,69 @@
+// tests/test_vknhasher.cpp
+#include "gtest/gtest.h"
+#include "../VknConfig/include/VknData.hpp" // Adjust path as necessary
+
+TEST(VknHasherTest, SameValues_SameHash)
+{
+    vkn::VknHasher a{};
+    vkn::VknHasher b{};
+    a.add(1u, 2.0f, uint8_t{3});
+    b.add(1u, 2.0f, uint8_t{3});
+    ASSERT_EQ(a.get(), b.get());
+    ASSERT_NE(a.get(), vkn::VknHasher{}.get());
+}
+
+TEST(VknHasherTest, OrderAndValues_ChangeHash)
+{
+    vkn::VknHasher a{};
+    vkn::VknHasher b{};
+    vkn::VknHasher c{};
+    a.add(1u, 2u);
+    b.add(2u, 1u);
+    c.add(1u, 3u);
+    ASSERT_NE(a.get(), b.get());
+    ASSERT_NE(a.get(), c.get());
+}
+
+TEST(VknHasherTest, Arrays_HashContentsAndCount)
+{
+    const uint32_t first[]{1u, 2u, 3u};
+    const uint32_t second[]{1u, 2u, 3u};
+    vkn::VknHasher a{};
+    vkn::VknHasher b{};
+    vkn::VknHasher shorter{};
+    vkn::VknHasher empty{};
+    vkn::VknHasher null{};
+    a.addArray(first, 3u);
+    b.addArray(second, 3u); // Different storage, same contents
+    shorter.addArray(first, 2u);
+    empty.addArray(first, 0u);
+    null.addArray<uint32_t>(nullptr, 3u);
+    ASSERT_EQ(a.get(), b.get());
+    ASSERT_NE(a.get(), shorter.get());
+    ASSERT_EQ(empty.get(), null.get()); // A null array counts as empty
+}
+
+TEST(VknHasherTest, Strings_HashContents)
+{
+    std::string name{"main"};
+    vkn::VknHasher a{};
+    vkn::VknHasher b{};
+    vkn::VknHasher other{};
+    a.addString("main");
+    b.addString(name.c_str());
+    other.addString("mainx");
+    ASSERT_EQ(a.get(), b.get());
+    ASSERT_NE(a.get(), other.get());
+}
+
+TEST(VknHasherTest, MatchesFnv1a128)
+{
+    vkn::VknHasher empty{};
+    vkn::VknHasher a{};
+    vkn::VknHasher foobar{};
+    a.addBytes("a", 1u);
+    foobar.addBytes("foobar", 6u);
+    ASSERT_EQ(empty.get(), (vkn::VknHash{0x6c62272e07bb0142ull, 0x62b821756295c58dull})); // Offset basis
+    ASSERT_EQ(a.get(), (vkn::VknHash{0xd228cb696f1a8cafull, 0x78912b704e4a8964ull}));
+    ASSERT_EQ(foobar.get(), (vkn::VknHash{0x343e1662793c64bfull, 0x6f0d3597ba446f18ull}));
+}
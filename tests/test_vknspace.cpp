@@ -297,3 +297,47 @@ TEST_F(VknSpaceTest, GetSubspaceSlice_OutOfBounds_Throws)
     ASSERT_EQ(space_int_default.getSubspaceSlice(0, 2).getSize(), 1); // Length too long
     ASSERT_TRUE(space_int_default.getSubspaceSlice(1, 1).isEmpty());  // Start too far
 }
+
+TEST_F(VknSpaceTest, WideIndex_DataBeyondDefaultCeiling)
+{
+    vkn::VknSpace<int, uint_least16_t> wide_space{1u};
+    wide_space[0].insert(7, 300);
+    ASSERT_EQ(wide_space[0](300), 7);
+    ASSERT_EQ(wide_space[0].getDataSize(), 1);
+}
+
+TEST_F(VknSpaceTest, MemoryResource_SharedByWholeTree)
+{
+    alignas(std::max_align_t) std::byte buffer[65536];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        vkn::VknSpace<int> space{2, 0, true, &arena};
+        for (uint32_t i = 0; i < 8; ++i)
+            for (uint32_t j = 0; j < 8; ++j)
+                space[i][j].append(static_cast<int>(i * 8 + j));
+        ASSERT_EQ(space[7][7](0), 63);
+        ASSERT_EQ(space[3].getMemoryResource(), &arena);
+        ASSERT_EQ(space[3][5].getDataVector().getMemoryResource(), &arena);
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+TEST_F(VknSpaceTest, FindAndTryGet_DoNotDive)
+{
+    vkn::VknSpace<int> space{2};
+    ASSERT_EQ(space.find(0), nullptr);
+    ASSERT_EQ(space.find(1, 2), nullptr);
+    ASSERT_EQ(space.tryGet(1, 2, 0), nullptr);
+    ASSERT_EQ(space.getNumSubspaces(), 0); // Nothing was created by the misses
+
+    space[1][2].insert(12, 3);
+    ASSERT_EQ(space.find(1), &space[1]);
+    ASSERT_EQ(space.find(1, 2), &space[1][2]);
+    ASSERT_EQ(*space.tryGet(1, 2, 3), 12);
+    ASSERT_EQ(space.tryGet(1, 2, 4), nullptr);
+    ASSERT_EQ(space.find(1, 3), nullptr);
+    ASSERT_EQ(space.find(200), nullptr);
+    ASSERT_EQ(space.getNumSubspaces(), 1);
+    ASSERT_EQ(space[1].getNumSubspaces(), 1);
+}
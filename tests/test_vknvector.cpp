@@ -508,4 +508,214 @@ TEST_F(VknVectorTest, VknVector_Swap)
     ASSERT_EQ(vec_int(0), 150);
     ASSERT_EQ(vec_int.getElement(1), nullptr);
     ASSERT_EQ(vec_int(2), 100);
-}
\ No newline at end of file
+}
+
+TEST_F(VknVectorTest, Lookup_ConsistentAfterRemove)
+{
+    vec_int.insert(7, 70);
+    vec_int.insert(2, 20);
+    vec_int.insert(4, 40);
+    vec_int.remove(2);
+    ASSERT_EQ(vec_int.exists(2), false);
+    ASSERT_EQ(vec_int(7), 70);
+    ASSERT_EQ(vec_int(4), 40);
+    vec_int.remove(4, 4);
+    ASSERT_EQ(vec_int.exists(4), false);
+    ASSERT_EQ(vec_int.exists(7), false);
+    ASSERT_EQ(vec_int.getSize(), 0);
+}
+
+TEST_F(VknVectorTest, Lookup_FollowsCopyAndMove)
+{
+    int arr[3] = {1, 2, 3};
+    vec_int.insert(10, arr, 3);
+    ASSERT_EQ(vec_int(12), 3);
+    vkn::VknVector<int> copy_vec(vec_int);
+    vec_int.swap(10, 12);
+    ASSERT_EQ(vec_int(10), 3);
+    ASSERT_EQ(copy_vec(10), 1);
+    vkn::VknVector<int> moved_vec(std::move(copy_vec));
+    ASSERT_EQ(copy_vec.exists(10), false);
+    ASSERT_EQ(moved_vec(11), 2);
+}
+
+TEST_F(VknVectorTest, Capacity_GrowsGeometrically)
+{
+    vec_int.appendOne(1);
+    int *firstData = vec_int.getData();
+    vec_int.appendOne(2);
+    ASSERT_EQ(vec_int.getCapacity(), 2);
+    vec_int.appendOne(3);
+    ASSERT_EQ(vec_int.getCapacity(), 4);
+    ASSERT_NE(vec_int.getData(), firstData);
+    int *dataAtFour = vec_int.getData();
+    vec_int.appendOne(4);
+    ASSERT_EQ(vec_int.getData(), dataAtFour); // No reallocation while within capacity
+    ASSERT_EQ(vec_int(3), 4);
+}
+
+TEST_F(VknVectorTest, Reserve_And_ShrinkToFit)
+{
+    vec_int.reserve(10);
+    ASSERT_EQ(vec_int.getCapacity(), 10);
+    ASSERT_TRUE(vec_int.isEmpty());
+    ASSERT_EQ(vec_int.getData(), nullptr);
+    int *reserved = vec_int.appendRepeat(7, 10);
+    ASSERT_EQ(vec_int.getData(), reserved);
+    ASSERT_THROW(vec_int.reserve(257), std::runtime_error);
+    vec_int.remove(9);
+    vec_int.appendOne(8);
+    vec_int.shrink_to_fit();
+    ASSERT_EQ(vec_int.getCapacity(), vec_int.getSize());
+    ASSERT_EQ(vec_int(9), 8); // Removing the last position frees it for the next append
+    vec_int.remove(0, 10);
+    vec_int.shrink_to_fit();
+    ExpectEmpty(vec_int);
+}
+
+TEST_F(VknVectorTest, WideIndex_ExceedsDefaultCeiling)
+{
+    vkn::VknVector<int, uint_least16_t> wide_vec;
+    ASSERT_EQ(wide_vec.s_maxDataSize, 65536u);
+    wide_vec.appendRepeat(1, 1000);
+    wide_vec.insert(4000, 40);
+    ASSERT_EQ(wide_vec.getSize(), 1001);
+    ASSERT_EQ(wide_vec.getNumPositions(), 4001);
+    ASSERT_EQ(wide_vec(999), 1);
+    ASSERT_EQ(wide_vec(4000), 40);
+    ASSERT_FALSE(wide_vec.exists(1000));
+    ASSERT_EQ(wide_vec.getDefragPos(10), 1000);
+    wide_vec.remove(500);
+    ASSERT_EQ(wide_vec.getDefragPos(1), 500);
+    ASSERT_THROW(wide_vec.getElement(65536), std::runtime_error);
+    ASSERT_EQ(wide_vec.getSlice(990, 10).getSize(), 10);
+}
+
+TEST_F(VknVectorTest, NonTrivialType_SurvivesGrowAndRemove)
+{
+    for (int i = 0; i < 20; ++i)
+        vec_str.appendOne(std::string(32, 'a' + i)); // Long enough to avoid the small string buffer
+    vec_str.remove(3);
+    vec_str.remove(10, 5);
+    vkn::VknVector<std::string> copy_vec{vec_str};
+    ASSERT_EQ(vec_str.getSize(), 14);
+    ASSERT_EQ(vec_str(2), std::string(32, 'c'));
+    ASSERT_EQ(vec_str(15), std::string(32, 'p'));
+    ASSERT_EQ(copy_vec(19), std::string(32, 't'));
+}
+
+TEST_F(VknVectorTest, TrivialType_NewSlotsZeroed)
+{
+    struct Info
+    {
+        int type;
+        const void *next;
+        float value;
+    };
+    vkn::VknVector<Info> infos;
+    infos.appendOne(Info{1, &infos, 2.0f});
+    Info *newInfos = infos.getData(3);
+    ASSERT_EQ(newInfos[2].type, 0);
+    ASSERT_EQ(newInfos[2].next, nullptr);
+    ASSERT_EQ(infos(0).next, &infos);
+}
+
+TEST_F(VknVectorTest, Remove_InPlace_KeepsStorage)
+{
+    vec_int.appendRepeat(5, 8);
+    int *data = vec_int.getData();
+    vec_int.remove(2);
+    vec_int.remove(4, 2);
+    ASSERT_EQ(vec_int.getData(), data);
+    ASSERT_EQ(vec_int.getCapacity(), 8);
+    ASSERT_EQ(vec_int.getSize(), 5);
+    ASSERT_EQ(vec_int.getNumPositions(), 8);
+    vec_int.remove(0, 8);
+    ExpectEmpty(vec_int);
+    vec_int.appendOne(1);
+    ASSERT_EQ(vec_int.getData(), data);
+}
+
+TEST_F(VknVectorTest, GetPosition_WalksStoragePastRemovedPositions)
+{
+    for (int i = 0; i < 5; ++i)
+        vec_int.appendOne(i * 10);
+    vec_int.remove(1);
+    vec_int.remove(3);
+    ASSERT_EQ(vec_int.getSize(), 3);
+    for (uint32_t idx = 0; idx < vec_int.getSize(); ++idx)
+        ASSERT_EQ(vec_int(vec_int.getPosition(idx)), vec_int.begin()[idx]);
+    ASSERT_EQ(vec_int.getPosition(1), 2);
+    ASSERT_THROW(vec_int.getPosition(3), std::runtime_error);
+}
+
+TEST_F(VknVectorTest, Compact_RenumbersDensely)
+{
+    vec_int.insert(9, 90);
+    vec_int.insert(2, 20);
+    vec_int.insert(5, 50);
+    vkn::VknVector<uint_least32_t> remap = vec_int.compact();
+    ASSERT_EQ(vec_int.getNumPositions(), 3);
+    ASSERT_EQ(remap(2), 0);
+    ASSERT_EQ(remap(5), 1);
+    ASSERT_EQ(remap(9), 2);
+    ASSERT_FALSE(remap.exists(3));
+    ASSERT_EQ(vec_int(1), 50);
+    ASSERT_EQ(vec_int.getSlice(0, 3).getData()[2], 90);
+    ASSERT_EQ(vec_int.getDefragPos(1), 3);
+}
+
+TEST_F(VknVectorTest, Occupancy_SearchAcrossWords)
+{
+    vkn::VknVector<int, uint16_t> wide;
+    wide.insert(300, 300);
+    wide.insert(3, 3);
+    wide.insert(130, 130);
+    wide.insert(64, 64);
+    wide.swap(64, 200);
+    ASSERT_FALSE(wide.exists(64));
+
+    std::vector<int> visited{};
+    vkn::VknVectorIterator<int, uint16_t> it = wide.getSlice(0, 301);
+    for (/*it*/; !it.isAtEnd(); ++it)
+        visited.push_back(*it);
+    ASSERT_EQ(visited, (std::vector<int>{3, 130, 64, 300}));
+    ASSERT_TRUE(wide.getSlice(131, 60).isEmpty());
+    ASSERT_EQ(wide.getSlice(4, 200).getSize(), 2);
+}
+
+TEST_F(VknVectorTest, Defrag_Pos_SkipsFullWords)
+{
+    vkn::VknVector<int, uint16_t> wide;
+    wide.appendRepeat(1, 200);
+    wide.remove(10);
+    wide.remove(100, 5);
+    wide.remove(199);
+    ASSERT_EQ(wide.getDefragPos(1), 10);
+    ASSERT_EQ(wide.getDefragPos(2), 100);
+    ASSERT_EQ(wide.getDefragPos(6), 199);
+    wide.insert(10, 1);
+    ASSERT_EQ(wide.getDefragPos(1), 100);
+}
+
+TEST_F(VknVectorTest, MemoryResource_AllAllocationsFromResource)
+{
+    alignas(std::max_align_t) std::byte buffer[16384];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        vkn::VknVector<std::string> vec{&arena};
+        ASSERT_EQ(vec.getMemoryResource(), &arena);
+        vec.appendRepeat("x", 40);
+        vec.insert(200, "y");
+        vec.remove(3);
+        vec.compact();
+        vkn::VknVector<std::string> moved{std::move(vec)};
+        ASSERT_EQ(moved.getMemoryResource(), &arena);
+        ASSERT_EQ(moved.getSize(), 40);
+        ASSERT_EQ(moved(39), "y");
+        ASSERT_THROW(moved.setMemoryResource(std::pmr::get_default_resource()), std::runtime_error);
+    }
+    std::pmr::set_default_resource(previous);
+    ASSERT_THROW(vkn::VknVector<int>{std::pmr::null_memory_resource()}.appendOne(1), std::bad_alloc);
+}
@@ -381,6 +381,40 @@ TEST_F(VknVectorIteratorTest, Iterate_SliceIncludesMinLogicalPosition)
     ASSERT_TRUE(it.isAtEnd());
 }
 
+TEST_F(VknVectorIteratorTest, GetSpan_ContiguousSlice)
+{
+    PopulateVector({{0, 10}, {1, 20}, {2, 30}, {3, 40}});
+    std::span<int> span = vec_int.getSlice(1, 3).getSpan();
+    ASSERT_EQ(span.size(), 3);
+    ASSERT_EQ(span.data(), vec_int.getData() + 1);
+    ASSERT_EQ(span[2], 40);
+    ASSERT_EQ(vec_int.getSpan(0, 4).size(), 4);
+    ASSERT_TRUE(vec_int.getSpan(2, 3).empty()); // Runs past the last position
+}
+
+TEST_F(VknVectorIteratorTest, GetSpan_OutOfOrderSlice)
+{
+    PopulateVector({{1, 20}, {0, 10}, {2, 30}}); // m_positions = {1, 0, 2}
+    ASSERT_TRUE(vec_int.getSpan(0, 2).empty());
+    ASSERT_EQ(vec_int.getSpan(1, 1).size(), 1);
+    vkn::VknVectorIterator<int> it = vec_int.getSlice(0, 3);
+    ASSERT_THROW(it.getSpan(), std::runtime_error);
+    ASSERT_TRUE(vec_int.getSlice(0, 0).getSpan().empty());
+}
+
+TEST_F(VknVectorIteratorTest, Iterate_ReverseInsertedFullRange)
+{
+    // Physical order is the reverse of logical order; every step has to find the next position
+    for (uint32_t pos = 200; pos > 0; --pos)
+        vec_int.insert(pos - 1, static_cast<int>(pos - 1) * 2);
+    vkn::VknVectorIterator<int> it = vec_int.getSlice(0, 200);
+    ASSERT_EQ(it.getSize(), 200);
+    int expected{0};
+    for (/*expected=0*/; !it.isAtEnd(); ++it, expected += 2)
+        ASSERT_EQ(*it, expected);
+    ASSERT_EQ(expected, 400);
+}
+
 // --- Iterator Helper Methods to Consider Adding (Public) ---
 // These would make testing and using the iterator easier:
 // bool isAtBegin() const;